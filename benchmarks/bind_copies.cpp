@@ -0,0 +1,129 @@
+// Bytes copied per parameter bind on SQLite, owning vs non-owning binds.
+//
+// Counts every heap byte allocated while binding and executing a large
+// parameter, on the C++ side (operator new) and inside SQLite (through
+// SQLITE_CONFIG_MALLOC). "SELECT ?" only references the bound value, so
+// what is counted is the cost of the bind itself:
+//  - string  : bind(idx, const std::string &), SQLITE_TRANSIENT
+//  - dbvalue : bind(idx, str(s)), DbValue copy + SQLITE_TRANSIENT
+//  - view    : bind(idx, std::string_view), SQLITE_STATIC
+//  - span    : bind(idx, std::span<const std::byte>), SQLITE_STATIC
+//
+// Usage: vix_db_bench_bind_copies [payload-bytes] [iterations]
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace vix::db;
+
+namespace
+{
+  std::atomic<std::uint64_t> cxx_bytes{0};
+  std::atomic<std::uint64_t> sqlite_bytes{0};
+
+  sqlite3_mem_methods base_mem{};
+
+  void *count_malloc(int n)
+  {
+    sqlite_bytes.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+    return base_mem.xMalloc(n);
+  }
+
+  void *count_realloc(void *p, int n)
+  {
+    sqlite_bytes.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+    return base_mem.xRealloc(p, n);
+  }
+
+  void install_sqlite_counter()
+  {
+    sqlite3_config(SQLITE_CONFIG_GETMALLOC, &base_mem);
+    sqlite3_mem_methods counting = base_mem;
+    counting.xMalloc = count_malloc;
+    counting.xRealloc = count_realloc;
+    sqlite3_config(SQLITE_CONFIG_MALLOC, &counting);
+  }
+
+  template <typename Bind>
+  void run(const char *name, Connection &c, std::size_t iters, std::size_t payload, Bind bind)
+  {
+    auto st = c.prepare("SELECT ?");
+
+    // Warm up: first execution allocates the VM registers.
+    bind(*st);
+    st->exec();
+
+    const auto cxx0 = cxx_bytes.load();
+    const auto sql0 = sqlite_bytes.load();
+    const auto t0 = std::chrono::steady_clock::now();
+
+    for (std::size_t i = 0; i < iters; ++i)
+    {
+      bind(*st);
+      st->exec();
+    }
+
+    const auto t1 = std::chrono::steady_clock::now();
+    const double n = static_cast<double>(iters);
+    const double cxx = static_cast<double>(cxx_bytes.load() - cxx0) / n;
+    const double sql = static_cast<double>(sqlite_bytes.load() - sql0) / n;
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / n;
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(0)
+              << std::setw(14) << cxx
+              << std::setw(14) << sql
+              << std::setw(12) << std::setprecision(2) << (cxx + sql) / static_cast<double>(payload)
+              << std::setw(12) << std::setprecision(0) << ns << "\n";
+  }
+} // namespace
+
+void *operator new(std::size_t n)
+{
+  cxx_bytes.fetch_add(n, std::memory_order_relaxed);
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char **argv)
+{
+  const std::size_t payload =
+      argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 64 * 1024;
+  const std::size_t iters =
+      argc > 2 ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : 20000;
+
+  install_sqlite_counter();
+
+  auto conn = make_sqlite_factory(":memory:")();
+  const std::string data(payload, 'x');
+  const std::span<const std::byte> bytes = std::as_bytes(std::span(data));
+
+  std::cout << "payload " << payload << " bytes, " << iters << " binds\n";
+  std::cout << "bind       C++ B/bind  SQLite B/bind  copies/bind     ns/bind\n";
+
+  run("string", *conn, iters, payload, [&](Statement &st)
+      { st.bind(1, data); });
+  run("dbvalue", *conn, iters, payload, [&](Statement &st)
+      { st.bind(1, str(data)); });
+  run("view", *conn, iters, payload, [&](Statement &st)
+      { st.bind(1, std::string_view(data)); });
+  run("span", *conn, iters, payload, [&](Statement &st)
+      { st.bind(1, bytes); });
+
+  return 0;
+}
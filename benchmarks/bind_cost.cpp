@@ -0,0 +1,112 @@
+// CPU cost of one parameter bind on SQLite, per C++ type.
+//
+// Binds the same parameters over and over on a prepared statement,
+// without executing it, so only the bind path is measured:
+//  - dbvalue : bind(idx, DbValue), the value wrapped in a std::variant
+//  - typed   : bind(idx, T), the overload for the C++ type
+//  - view    : bind(idx, DbValueView), text referenced rather than copied
+//
+// Usage: vix_db_bench_bind_cost [iterations]
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace vix::db;
+
+namespace
+{
+  template <typename Bind>
+  double ns_per_bind(Statement &st, std::size_t iters, Bind bind)
+  {
+    // Warm up caches and the branch predictor.
+    for (std::size_t i = 0; i < iters / 10; ++i)
+      bind(st, i);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iters; ++i)
+      bind(st, i);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(iters);
+  }
+
+  template <typename ViaDbValue, typename Typed, typename ViaView>
+  void run(const char *name, Statement &st, std::size_t iters, ViaDbValue via_value, Typed typed,
+           ViaView via_view)
+  {
+    const double a = ns_per_bind(st, iters, via_value);
+    const double b = ns_per_bind(st, iters, typed);
+    const double c = ns_per_bind(st, iters, via_view);
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(12) << a
+              << std::setw(12) << b
+              << std::setw(12) << c << "\n";
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const std::size_t iters =
+      argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 10'000'000;
+
+  auto conn = make_sqlite_factory(":memory:")();
+  auto st = conn->prepare("SELECT ?");
+  const std::string text = "a short text value";
+
+  std::cout << iters << " binds per case\n";
+  std::cout << "type       dbvalue ns    typed ns     view ns\n";
+
+  run(
+      "int64", *st, iters,
+      [](Statement &s, std::size_t i)
+      { s.bind(1, i64(static_cast<std::int64_t>(i))); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, static_cast<std::int64_t>(i)); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, DbValueView{static_cast<std::int64_t>(i)}); });
+  run(
+      "double", *st, iters,
+      [](Statement &s, std::size_t i)
+      { s.bind(1, f64(static_cast<double>(i))); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, static_cast<double>(i)); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, DbValueView{static_cast<double>(i)}); });
+  run(
+      "bool", *st, iters,
+      [](Statement &s, std::size_t i)
+      { s.bind(1, b((i & 1) != 0)); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, (i & 1) != 0); },
+      [](Statement &s, std::size_t i)
+      { s.bind(1, DbValueView{(i & 1) != 0}); });
+  run(
+      "text", *st, iters,
+      [&](Statement &s, std::size_t)
+      { s.bind(1, str(text)); },
+      [&](Statement &s, std::size_t)
+      { s.bind(1, text); },
+      [&](Statement &s, std::size_t)
+      { s.bind(1, DbValueView{std::string_view(text)}); });
+  run(
+      "null", *st, iters,
+      [](Statement &s, std::size_t)
+      { s.bind(1, null()); },
+      [](Statement &s, std::size_t)
+      { s.bindNull(1); },
+      [](Statement &s, std::size_t)
+      { s.bind(1, DbValueView{nullptr}); });
+
+  return 0;
+}
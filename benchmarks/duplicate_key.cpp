@@ -0,0 +1,84 @@
+// Cost of an expected failure on SQLite.
+//
+// Inserts rows whose key already exists, the common case of an
+// insert-then-update upsert, and reports it two ways:
+//  - throw : exec(), catching DBError
+//  - value : tryExec(), checking DbErrorCode::DuplicateKey
+//
+// Usage: vix_db_bench_duplicate_key [inserts]
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+using namespace vix::db;
+
+namespace
+{
+  constexpr std::int64_t kKeys = 1000;
+
+  template <typename Insert>
+  void run(const char *name, std::size_t n, Insert insert)
+  {
+    std::size_t duplicates = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+      duplicates += insert(static_cast<std::int64_t>(i) % kKeys) ? 0 : 1;
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    std::cout << std::left << std::setw(8) << name << std::right
+              << std::fixed << std::setprecision(0)
+              << std::setw(14) << ns / static_cast<double>(n)
+              << std::setw(14) << duplicates << "\n";
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const std::size_t n =
+      argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 200'000;
+
+  auto conn = make_sqlite_factory(":memory:")();
+  conn->prepare("CREATE TABLE kv (k INTEGER PRIMARY KEY, v INTEGER)")->exec();
+  for (std::int64_t k = 0; k < kKeys; ++k)
+  {
+    auto st = conn->prepare("INSERT INTO kv VALUES (?, 0)");
+    st->bind(1, k);
+    st->exec();
+  }
+
+  auto st = conn->prepare("INSERT INTO kv VALUES (?, 1)");
+
+  std::cout << n << " inserts of existing keys\n";
+  std::cout << "report      ns/insert    duplicates\n";
+
+  run("throw", n, [&](std::int64_t k)
+      {
+        st->bind(1, k);
+        try
+        {
+          st->exec();
+          return true;
+        }
+        catch (const DBError &)
+        {
+          return false;
+        } });
+
+  run("value", n, [&](std::int64_t k)
+      {
+        st->bind(1, k);
+        const auto r = st->tryExec();
+        if (!r && r.error().code != DbErrorCode::DuplicateKey)
+          raise(r.error());
+        return r.has_value(); });
+
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Holding a whole SQLite result in memory.
+//
+// Reads the same query two ways and counts heap allocations:
+//  - values    : one std::vector<DbValue> per row, filled with getValue()
+//  - rowbuffer : ResultSet::materialize() into a RowBuffer
+//
+// then replays each copy once, summing an integer column.
+//
+// Usage: vix_db_bench_materialize [rows]
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace vix::db;
+
+namespace
+{
+  std::atomic<std::size_t> g_allocs{0};
+}
+
+void *operator new(std::size_t n)
+{
+  g_allocs.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+  constexpr const char *kQuery = "SELECT id, name, email, score FROM users";
+
+  void fill(Connection &c, std::size_t rows)
+  {
+    c.prepare("CREATE TABLE users (id INTEGER, name TEXT, email TEXT, score REAL)")->exec();
+
+    ParamBatch batch(4);
+    batch.reserve(rows);
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+      const std::string name = "user number " + std::to_string(i);
+      batch.add(static_cast<std::int64_t>(i), name, name + "@example.com", static_cast<double>(i) * 0.5);
+    }
+
+    c.begin();
+    c.insertMany("users", {"id", "name", "email", "score"}, batch);
+    c.commit();
+  }
+
+  std::int64_t by_values(Connection &c)
+  {
+    std::vector<std::vector<DbValue>> rows;
+    auto rs = c.prepare(kQuery)->query();
+    while (rs->next())
+    {
+      std::vector<DbValue> row;
+      row.reserve(4);
+      for (std::size_t i = 0; i < 4; ++i)
+        row.push_back(rs->row().getValue(i));
+      rows.push_back(std::move(row));
+    }
+
+    std::int64_t sum = 0;
+    for (const auto &row : rows)
+      sum += std::get<std::int64_t>(row[0]);
+    return sum;
+  }
+
+  std::int64_t by_rowbuffer(Connection &c)
+  {
+    RowBuffer rows = c.prepare(kQuery)->query()->materialize();
+
+    std::int64_t sum = 0;
+    for (const auto &row : rows)
+      sum += row.getInt64(0);
+    return sum;
+  }
+
+  template <typename Scan>
+  void run(const char *name, std::size_t rows, Scan scan)
+  {
+    const std::size_t a0 = g_allocs.load();
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::int64_t sum = scan();
+    const auto t1 = std::chrono::steady_clock::now();
+    const std::size_t allocs = g_allocs.load() - a0;
+
+    const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(10) << ms
+              << std::setw(14) << allocs
+              << std::setw(12) << std::setprecision(2) << static_cast<double>(allocs) / static_cast<double>(rows)
+              << std::setw(16) << sum << "\n";
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const std::size_t rows =
+      argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 1'000'000;
+
+  auto conn = make_sqlite_factory(":memory:")();
+  fill(*conn, rows);
+
+  std::cout << rows << " rows\n";
+  std::cout << "copy              ms        allocs    allocs/row        checksum\n";
+
+  run("values", rows, [&]
+      { return by_values(*conn); });
+  run("rowbuffer", rows, [&]
+      { return by_rowbuffer(*conn); });
+
+  return 0;
+}
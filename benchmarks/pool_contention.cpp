@@ -0,0 +1,152 @@
+// Acquire/release throughput of ConnectionPool against thread count.
+//
+// Compares three setups on an in-memory connection (no database needed):
+//  - legacy : the previous design, one mutex + one queue for every call
+//  - shared : ConnectionPool with PoolConfig::local_cache = false
+//  - tiered : ConnectionPool with per-thread local slots (default)
+//
+// Usage: vix_db_bench_pool_contention [iterations-per-thread]
+
+#include <vix/db/db.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace vix::db;
+
+namespace
+{
+  struct NullConnection final : Connection
+  {
+    std::unique_ptr<Statement> prepare(std::string_view) override
+    {
+      throw DBError("NullConnection::prepare");
+    }
+    void begin() override {}
+    void commit() override {}
+    void rollback() override {}
+    std::uint64_t lastInsertId() override { return 0; }
+  };
+
+  ConnectionFactory null_factory()
+  {
+    return []() -> ConnectionPtr
+    { return std::make_shared<NullConnection>(); };
+  }
+
+  // Baseline algorithm kept here for comparison only.
+  class LegacyPool
+  {
+    ConnectionFactory factory_;
+    PoolConfig cfg_{};
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::queue<ConnectionPtr> idle_;
+    std::size_t total_ = 0;
+
+  public:
+    LegacyPool(ConnectionFactory factory, PoolConfig cfg)
+        : factory_(std::move(factory)), cfg_(cfg) {}
+
+    ConnectionPtr acquire()
+    {
+      std::unique_lock lk(m_);
+      for (;;)
+      {
+        while (!idle_.empty())
+        {
+          auto c = idle_.front();
+          idle_.pop();
+          if (c && c->ping())
+            return c;
+          --total_;
+        }
+        if (total_ < cfg_.max)
+        {
+          ++total_;
+          lk.unlock();
+          return factory_();
+        }
+        cv_.wait(lk, [&]
+                 { return !idle_.empty(); });
+      }
+    }
+
+    void release(ConnectionPtr c)
+    {
+      {
+        std::lock_guard lk(m_);
+        idle_.push(std::move(c));
+      }
+      cv_.notify_one();
+    }
+  };
+
+  template <typename Pool>
+  double run(Pool &pool, std::size_t threads, std::size_t iters)
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+      workers.emplace_back([&]
+                           {
+        for (std::size_t i = 0; i < iters; ++i)
+        {
+          auto c = pool.acquire();
+          pool.release(std::move(c));
+        } });
+    }
+    for (auto &w : workers)
+      w.join();
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(threads * iters) / secs;
+  }
+} // namespace
+
+int main(int argc, char **argv)
+{
+  const std::size_t iters =
+      argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : 200000;
+
+  std::cout << "threads      legacy ops/s      shared ops/s      tiered ops/s\n";
+
+  for (std::size_t threads : {1u, 2u, 4u, 8u, 16u, 32u, 64u})
+  {
+    PoolConfig cfg;
+    cfg.min = 0;
+    cfg.max = threads;
+
+    LegacyPool legacy(null_factory(), cfg);
+
+    cfg.local_cache = false;
+    ConnectionPool shared(null_factory(), cfg);
+
+    cfg.local_cache = true;
+    ConnectionPool tiered(null_factory(), cfg);
+
+    const double a = run(legacy, threads, iters);
+    const double b = run(shared, threads, iters);
+    const double c = run(tiered, threads, iters);
+
+    std::cout << std::setw(7) << threads
+              << std::fixed << std::setprecision(0)
+              << std::setw(18) << a
+              << std::setw(18) << b
+              << std::setw(18) << c << "\n";
+  }
+
+  return 0;
+}
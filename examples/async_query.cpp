@@ -0,0 +1,99 @@
+#include <vix/db/db.hpp>
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <mutex>
+
+using namespace vix::db;
+
+// Minimal single-threaded event loop standing in for the application's.
+struct Loop
+{
+  std::mutex m;
+  std::condition_variable cv;
+  std::deque<std::function<void()>> q;
+  bool done = false;
+
+  void post(std::function<void()> fn)
+  {
+    {
+      std::lock_guard lk(m);
+      q.push_back(std::move(fn));
+    }
+    cv.notify_one();
+  }
+
+  void run()
+  {
+    std::unique_lock lk(m);
+    while (!done)
+    {
+      cv.wait(lk, [&]
+              { return !q.empty(); });
+      auto fn = std::move(q.front());
+      q.pop_front();
+      lk.unlock();
+      fn();
+      lk.lock();
+    }
+  }
+};
+
+// Fire-and-forget coroutine type.
+struct Task
+{
+  struct promise_type
+  {
+    Task get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+static Task list_adults(AsyncDb &adb, Loop &loop)
+{
+  try
+  {
+    Rows rows = co_await adb.query("SELECT id, name FROM users WHERE age > ?", 18);
+    for (const auto &r : rows)
+      std::cout << std::get<std::int64_t>(r[0]) << " " << std::get<std::string>(r[1]) << "\n";
+
+    auto n = co_await adb.exec("UPDATE users SET seen = seen + 1 WHERE age > ?", 18);
+    std::cout << n << " rows updated\n";
+  }
+  catch (const DBError &e)
+  {
+    std::cerr << e.what() << "\n";
+  }
+
+  // Runs on the loop thread, where every continuation is resumed.
+  loop.done = true;
+}
+
+int main()
+{
+  DbConfig cfg;
+  cfg.engine = Engine::MySQL;
+  cfg.mysql.host = "tcp://127.0.0.1:3306";
+  cfg.mysql.user = "root";
+  cfg.mysql.password = "";
+  cfg.mysql.database = "vixdb";
+  cfg.mysql.pool.min = 1;
+  cfg.mysql.pool.max = 8;
+
+  Database db(cfg);
+  DbExecutor exec(cfg.mysql.pool.max);
+  Loop loop;
+
+  AsyncDb adb(db.pool(), exec, [&](std::function<void()> fn)
+              { loop.post(std::move(fn)); });
+
+  list_adults(adb, loop);
+  loop.run();
+}
@@ -24,9 +24,6 @@ int main()
   // or: st->bind(1, i64(18));
 
   auto rs = st->query();
-  while (rs->next())
-  {
-    const auto &row = rs->row();
+  for (const auto &row : *rs)
     std::cout << row.getInt64(0) << " " << row.getString(1) << "\n";
-  }
 }
@@ -15,8 +15,17 @@
 #ifndef VIX_DB_DATABASE_HPP
 #define VIX_DB_DATABASE_HPP
 
+#include <atomic>
+#include <future>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <vix/db/pool/ConnectionPool.hpp>
+#include <vix/db/pool/ReplicaPool.hpp>
 
 namespace vix::config
 {
@@ -37,6 +46,41 @@ namespace vix::db
     SQLite
   };
 
+  /**
+   * @brief How a Database opens its initial connections.
+   */
+  enum class Startup
+  {
+    /// The constructor returns once PoolConfig::min connections are open
+    Blocking,
+
+    /// The constructor returns immediately; see Database::ready()
+    Async
+  };
+
+  /**
+   * @brief Read replica endpoint of a MySQL database.
+   *
+   * Empty credentials and database name are taken from the primary.
+   */
+  struct MySQLReplicaConfig
+  {
+    /// Replica host
+    std::string host;
+
+    /// Username (defaults to the primary's)
+    std::string user;
+
+    /// Password (defaults to the primary's)
+    std::string password;
+
+    /// Database name (defaults to the primary's)
+    std::string database;
+
+    /// Connection pool configuration of this replica
+    PoolConfig pool{};
+  };
+
   /**
    * @brief Configuration parameters for a MySQL database.
    */
@@ -56,6 +100,12 @@ namespace vix::db
 
     /// Connection pool configuration
     PoolConfig pool{};
+
+    /// Prepared statements cached per connection (0 disables the cache)
+    std::size_t statement_cache = kDefaultStatementCache;
+
+    /// Read replicas, served by Database::reader()
+    std::vector<MySQLReplicaConfig> replicas{};
   };
 
   /**
@@ -68,6 +118,9 @@ namespace vix::db
 
     /// Connection pool configuration
     PoolConfig pool{};
+
+    /// Prepared statements cached per connection (0 disables the cache)
+    std::size_t statement_cache = kDefaultStatementCache;
   };
 
   /**
@@ -86,6 +139,9 @@ namespace vix::db
 
     /// SQLite-specific configuration
     SQLiteConfig sqlite{};
+
+    /// Initial connection strategy
+    Startup startup{Startup::Blocking};
   };
 
   /**
@@ -99,6 +155,19 @@ namespace vix::db
    */
   DbConfig make_db_config_from_vix_config(const vix::config::Config &cfg);
 
+  /**
+   * @brief Whether a statement only reads and may run on a replica.
+   *
+   * Conservative: anything not recognized as a plain read, including
+   * locking reads, SELECT ... INTO, WITH clauses, session functions
+   * such as LAST_INSERT_ID() or GET_LOCK() and user variables, is
+   * reported as a write.
+   *
+   * @param sql SQL statement.
+   * @return true for plain SELECT, SHOW and DESCRIBE statements.
+   */
+  bool is_read_only_sql(std::string_view sql) noexcept;
+
   /**
    * @brief High-level database facade.
    *
@@ -108,6 +177,10 @@ namespace vix::db
    *
    * Engine selection and driver wiring are performed at construction
    * time based on the provided DbConfig.
+   *
+   * When read replicas are configured, each gets its own pool and
+   * reads can be routed to them with reader() or route(); pool() and
+   * writer() always address the primary.
    */
   class Database
   {
@@ -116,12 +189,34 @@ namespace vix::db
      * @brief Construct a database instance.
      *
      * Initializes the underlying connection pool according to
-     * the selected engine and configuration.
+     * the selected engine and configuration. With Startup::Async the
+     * pool is warmed up on a background thread and the constructor
+     * returns immediately; callers that acquire a connection before
+     * warmup completes are served as connections come up.
      *
      * @param cfg Database configuration.
      */
     explicit Database(const DbConfig &cfg);
 
+    /**
+     * @brief Wait for a background warmup to finish.
+     */
+    ~Database();
+
+    Database(const Database &) = delete;
+    Database &operator=(const Database &) = delete;
+
+    /**
+     * @brief Readiness of the connection pool.
+     *
+     * Becomes ready as soon as the first connection is open, or holds
+     * the connection error if warmup failed without opening any. With
+     * Startup::Blocking it is already ready when the constructor returns.
+     *
+     * @return Shared future signalling readiness.
+     */
+    const std::shared_future<void> &ready() const noexcept { return ready_; }
+
     /**
      * @brief Return the selected database engine.
      *
@@ -150,11 +245,73 @@ namespace vix::db
      */
     const ConnectionPool &pool() const noexcept { return pool_; }
 
+    /**
+     * @brief Lease a connection on the primary.
+     *
+     * @return Routed connection to the primary.
+     */
+    RoutedConn writer();
+
+    /**
+     * @brief Lease a connection for reading.
+     *
+     * Picks the healthy replica with the fewest outstanding leases. A
+     * replica that fails to connect is put in backoff and the next one
+     * is tried; with no healthy replica the primary serves the read.
+     *
+     * Replicas lag behind the primary: reads that must observe the
+     * caller's own writes, or run inside a transaction, belong on
+     * writer().
+     *
+     * @return Routed connection to a replica or to the primary.
+     * @throws PoolTimeout if the chosen pool's acquire_timeout expires.
+     */
+    RoutedConn reader();
+
+    /**
+     * @brief Lease a connection suited to a statement.
+     *
+     * Statements accepted by is_read_only_sql() go to reader();
+     * everything else, including locking reads such as
+     * SELECT ... FOR UPDATE, goes to writer().
+     *
+     * @param sql Statement that will run on the connection.
+     * @return Routed connection.
+     */
+    RoutedConn route(std::string_view sql);
+
+    /**
+     * @brief Read replicas of this database.
+     *
+     * @return Replica pools, in configuration order.
+     */
+    const std::vector<std::unique_ptr<ReplicaPool>> &replicas() const noexcept { return replicas_; }
+
+    /**
+     * @brief Snapshot the statistics of every pool owned by this database.
+     *
+     * @return Pool name and statistics pairs.
+     */
+    std::vector<std::pair<std::string, PoolStats>> poolStats() const;
+
   private:
     DbConfig cfg_;
     ConnectionPool pool_;
+    std::vector<std::unique_ptr<ReplicaPool>> replicas_;
+    std::atomic<std::size_t> next_replica_{0};
+    std::promise<void> ready_promise_;
+    std::shared_future<void> ready_;
+    std::thread warmer_;
   };
 
+  /**
+   * @brief Render the pool metrics of a database in Prometheus text format.
+   *
+   * @param db Database whose pools are exported.
+   * @return Exposition text.
+   */
+  std::string render_prometheus(const Database &db);
+
 } // namespace vix::db
 
 #endif // VIX_DB_DATABASE_HPP
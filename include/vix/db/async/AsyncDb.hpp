@@ -0,0 +1,265 @@
+/**
+ *
+ *  @file AsyncDb.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_ASYNC_DB_HPP
+#define VIX_DB_ASYNC_DB_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vix/db/async/DbExecutor.hpp>
+#include <vix/db/core/Drivers.hpp>
+#include <vix/db/pool/ConnectionPool.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief Executor on which awaiting coroutines are resumed.
+   *
+   * Receives the continuation and must run it eventually, typically by
+   * posting it to the caller's event loop. An empty function resumes
+   * the coroutine directly on the database executor thread.
+   */
+  using CompletionExecutor = std::function<void(std::function<void()>)>;
+
+  /// Rows fully read on the database executor, one DbValue per column
+  using Rows = std::vector<std::vector<DbValue>>;
+
+  /**
+   * @brief Awaitable running one blocking job on a DbExecutor.
+   *
+   * co_await posts the job to the database executor and suspends; once
+   * the job has finished, the coroutine is resumed through the
+   * completion executor and receives the result, or the exception the
+   * job threw. Each awaitable can be awaited once.
+   *
+   * @tparam T Result type of the job (may be void).
+   */
+  template <typename T>
+  class [[nodiscard]] DbAwaitable
+  {
+    using Stored = std::conditional_t<std::is_void_v<T>, bool, T>;
+
+    DbExecutor &exec_;
+    CompletionExecutor done_;
+    std::function<T()> job_;
+    std::optional<Stored> value_;
+    std::exception_ptr error_;
+
+    void complete()
+    {
+      try
+      {
+        if constexpr (std::is_void_v<T>)
+        {
+          job_();
+          value_.emplace(true);
+        }
+        else
+        {
+          value_.emplace(job_());
+        }
+      }
+      catch (...)
+      {
+        error_ = std::current_exception();
+      }
+    }
+
+  public:
+    DbAwaitable(DbExecutor &exec, CompletionExecutor done, std::function<T()> job)
+        : exec_(exec), done_(std::move(done)), job_(std::move(job)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> h)
+    {
+      // Nothing may touch *this after post(): the job can resume the
+      // coroutine, and destroy this awaitable, before post() returns.
+      // Likewise after complete(): the completion executor may resume
+      // the coroutine on another thread before it returns, so it is
+      // moved out and called from the job's own frame.
+      exec_.post([this, h]
+                 {
+        complete();
+        CompletionExecutor done = std::move(done_);
+        if (done)
+          done([h]
+               { h.resume(); });
+        else
+          h.resume(); });
+    }
+
+    T await_resume()
+    {
+      if (error_)
+        std::rethrow_exception(error_);
+      if constexpr (!std::is_void_v<T>)
+        return std::move(*value_);
+    }
+  };
+
+  namespace detail
+  {
+    /// Argument type kept alive until the job runs on the executor
+    template <typename A>
+    using bound_arg_t = std::conditional_t<
+        std::is_convertible_v<std::decay_t<A>, const char *>,
+        std::string,
+        std::decay_t<A>>;
+
+    template <typename... Args>
+    void bind_all(Statement &st, const Args &...args)
+    {
+      std::size_t i = 1;
+      (st.bind(i++, args), ...);
+    }
+  } // namespace detail
+
+  /**
+   * @brief Coroutine front-end over a ConnectionPool.
+   *
+   * Every call returns a DbAwaitable whose job acquires a pooled
+   * connection, does its work and releases the connection, all on the
+   * database executor; the awaiting coroutine never blocks its thread.
+   *
+   * @code
+   * DbExecutor exec(pool_cfg.max);
+   * AsyncDb adb(db.pool(), exec, [&](auto fn) { loop.post(std::move(fn)); });
+   *
+   * Rows rows = co_await adb.query("SELECT id, name FROM users WHERE age > ?", 18);
+   * @endcode
+   *
+   * The pool and the executor must outlive every pending awaitable.
+   */
+  class AsyncDb
+  {
+    ConnectionPool &pool_;
+    DbExecutor &exec_;
+    CompletionExecutor done_;
+
+  public:
+    /**
+     * @brief Build an asynchronous front-end.
+     *
+     * @param pool Pool connections are taken from.
+     * @param exec Executor that runs the blocking driver calls.
+     * @param done Executor awaiting coroutines are resumed on.
+     */
+    AsyncDb(ConnectionPool &pool, DbExecutor &exec, CompletionExecutor done = {})
+        : pool_(pool), exec_(exec), done_(std::move(done)) {}
+
+    /**
+     * @brief Run a callable with a pooled connection.
+     *
+     * Use this for several statements, or a transaction, on the same
+     * connection in a single executor hop.
+     *
+     * @param fn Callable invoked as fn(Connection&).
+     * @return Awaitable yielding fn's result.
+     */
+    template <typename Fn>
+    auto run(Fn fn) -> DbAwaitable<std::invoke_result_t<Fn &, Connection &>>
+    {
+      using R = std::invoke_result_t<Fn &, Connection &>;
+      return DbAwaitable<R>(
+          exec_, done_,
+          [&pool = pool_, fn = std::move(fn)]() mutable -> R
+          {
+            PooledConn c(pool);
+            return fn(*c);
+          });
+    }
+
+    /**
+     * @brief Acquire a pooled connection without blocking the caller.
+     *
+     * The wait for a free connection happens on the executor; the
+     * connection is then used from the resumed coroutine.
+     *
+     * @return Awaitable yielding the pooled connection.
+     */
+    DbAwaitable<PooledConn> acquire()
+    {
+      return DbAwaitable<PooledConn>(
+          exec_, done_,
+          [&pool = pool_]
+          { return PooledConn(pool); });
+    }
+
+    /**
+     * @brief Prepare, bind and run a query, reading every row.
+     *
+     * @param sql SQL text with positional placeholders.
+     * @param args Values bound to placeholders 1..N.
+     * @return Awaitable yielding the materialized rows.
+     */
+    template <typename... Args>
+    DbAwaitable<Rows> query(std::string sql, Args &&...args)
+    {
+      return run(
+          [sql = std::move(sql),
+           ... args = detail::bound_arg_t<Args>(std::forward<Args>(args))](Connection &c)
+          {
+            auto st = c.prepare(sql);
+            detail::bind_all(*st, args...);
+
+            auto rs = st->query();
+            const std::size_t n = rs->cols();
+
+            Rows rows;
+            while (rs->next())
+            {
+              const auto &row = rs->row();
+              auto &out = rows.emplace_back();
+              out.reserve(n);
+              for (std::size_t i = 0; i < n; ++i)
+                out.push_back(row.getValue(i));
+            }
+            return rows;
+          });
+    }
+
+    /**
+     * @brief Prepare, bind and execute a statement.
+     *
+     * @param sql SQL text with positional placeholders.
+     * @param args Values bound to placeholders 1..N.
+     * @return Awaitable yielding the number of affected rows.
+     */
+    template <typename... Args>
+    DbAwaitable<std::uint64_t> exec(std::string sql, Args &&...args)
+    {
+      return run(
+          [sql = std::move(sql),
+           ... args = detail::bound_arg_t<Args>(std::forward<Args>(args))](Connection &c)
+          {
+            auto st = c.prepare(sql);
+            detail::bind_all(*st, args...);
+            return st->exec();
+          });
+    }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_ASYNC_DB_HPP
@@ -0,0 +1,79 @@
+/**
+ *
+ *  @file DbExecutor.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_DB_EXECUTOR_HPP
+#define VIX_DB_DB_EXECUTOR_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vix::db
+{
+  /**
+   * @brief Fixed-size thread pool dedicated to blocking database work.
+   *
+   * Drivers block on I/O, so database calls issued from asynchronous
+   * code are run here instead of on request threads. Size it close to
+   * PoolConfig::max: more threads than connections only adds waiters.
+   */
+  class DbExecutor
+  {
+    std::mutex m_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool stop_ = false;
+
+    void run();
+
+  public:
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param threads Number of worker threads (at least one is started).
+     */
+    explicit DbExecutor(std::size_t threads);
+
+    /**
+     * @brief Run the tasks already queued, then join the workers.
+     */
+    ~DbExecutor();
+
+    DbExecutor(const DbExecutor &) = delete;
+    DbExecutor &operator=(const DbExecutor &) = delete;
+
+    /**
+     * @brief Queue a task for execution on a worker thread.
+     *
+     * @param task Callable to run. Exceptions escaping it are dropped.
+     * @throws DBError if the executor is shutting down.
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief Number of worker threads.
+     *
+     * @return Worker count.
+     */
+    std::size_t size() const noexcept { return workers_.size(); }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_DB_EXECUTOR_HPP
@@ -0,0 +1,139 @@
+/**
+ *
+ *  @file Batch.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_BATCH_HPP
+#define VIX_DB_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vix/db/core/Errors.hpp>
+#include <vix/db/core/Value.hpp>
+
+namespace vix::db
+{
+  namespace detail
+  {
+    /// Conversions used when filling a ParamBatch, mirroring Statement::bind
+    inline DbValue to_db_value(const DbValue &v) { return v; }
+    inline DbValue to_db_value(int v) { return i64(v); }
+    inline DbValue to_db_value(unsigned v) { return i64(static_cast<std::int64_t>(v)); }
+    inline DbValue to_db_value(std::int64_t v) { return i64(v); }
+    inline DbValue to_db_value(std::uint64_t v) { return i64(static_cast<std::int64_t>(v)); }
+    inline DbValue to_db_value(double v) { return f64(v); }
+    inline DbValue to_db_value(bool v) { return b(v); }
+    inline DbValue to_db_value(std::string v) { return str(std::move(v)); }
+    inline DbValue to_db_value(std::string_view v) { return str(std::string(v)); }
+    inline DbValue to_db_value(const char *v) { return str(std::string(v ? v : "")); }
+  } // namespace detail
+
+  /**
+   * @brief Parameter rows for Statement::execBatch().
+   *
+   * Stores the values of every row contiguously, row after row, each
+   * row holding width() values bound to placeholders 1..width().
+   */
+  class ParamBatch
+  {
+    std::size_t width_;
+    std::vector<DbValue> values_;
+
+  public:
+    /**
+     * @brief Create an empty batch.
+     *
+     * @param width Number of parameters per row.
+     */
+    explicit ParamBatch(std::size_t width) : width_(width) {}
+
+    /// Parameters per row
+    std::size_t width() const noexcept { return width_; }
+
+    /// Number of rows
+    std::size_t size() const noexcept { return width_ ? values_.size() / width_ : 0; }
+
+    /// Whether the batch has no rows
+    bool empty() const noexcept { return values_.empty(); }
+
+    /**
+     * @brief Reserve room for a number of rows.
+     *
+     * @param rows Expected row count.
+     */
+    void reserve(std::size_t rows) { values_.reserve(rows * width_); }
+
+    /**
+     * @brief Remove every row, keeping the capacity.
+     */
+    void clear() noexcept { values_.clear(); }
+
+    /**
+     * @brief Append a row from C++ values.
+     *
+     * @param args One value per parameter.
+     * @throws DBError if the number of values differs from width().
+     */
+    template <typename... Args>
+    void add(Args &&...args)
+    {
+      if (sizeof...(Args) != width_)
+        throw DBError("ParamBatch::add: row width mismatch");
+      (values_.push_back(detail::to_db_value(std::forward<Args>(args))), ...);
+    }
+
+    /**
+     * @brief Append a row of DbValue.
+     *
+     * @param row One value per parameter.
+     * @throws DBError if the row size differs from width().
+     */
+    void addRow(std::span<const DbValue> row)
+    {
+      if (row.size() != width_)
+        throw DBError("ParamBatch::addRow: row width mismatch");
+      values_.insert(values_.end(), row.begin(), row.end());
+    }
+
+    /**
+     * @brief Access one row.
+     *
+     * @param i Row index (zero-based).
+     * @return The row's values.
+     */
+    std::span<const DbValue> row(std::size_t i) const noexcept
+    {
+      return std::span<const DbValue>(values_).subspan(i * width_, width_);
+    }
+
+    /**
+     * @brief Access a run of consecutive rows.
+     *
+     * @param first First row index.
+     * @param count Number of rows.
+     * @return Values of the rows, row after row.
+     */
+    std::span<const DbValue> rows(std::size_t first, std::size_t count) const noexcept
+    {
+      return std::span<const DbValue>(values_).subspan(first * width_, count * width_);
+    }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_BATCH_HPP
@@ -0,0 +1,77 @@
+/**
+ *
+ *  @file BulkInsert.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_BULK_INSERT_HPP
+#define VIX_DB_BULK_INSERT_HPP
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vix/db/core/Value.hpp>
+
+namespace vix::db
+{
+  /// Upper bound on the rows of one generated INSERT statement
+  inline constexpr std::size_t kMaxInsertRows = 1000;
+
+  /**
+   * @brief Driver limits bounding one multi-row INSERT statement.
+   */
+  struct InsertLimits
+  {
+    /// Maximum number of placeholders in one statement
+    std::size_t max_params = 999;
+
+    /// Maximum size in bytes of the SQL text plus bound values, 0 for no limit
+    std::size_t max_bytes = 0;
+  };
+
+  /**
+   * @brief Quote an identifier, each part of a dotted name separately.
+   *
+   * "db.users" quoted with '`' gives "`db`.`users`". Quote characters
+   * inside the name are doubled.
+   *
+   * @param name  Identifier, optionally schema-qualified.
+   * @param quote Quote character of the SQL dialect.
+   * @return Quoted identifier.
+   */
+  std::string quote_identifier(std::string_view name, char quote);
+
+  /**
+   * @brief Build "INSERT INTO t (c1, c2) VALUES (?, ?), (?, ?), ...".
+   *
+   * @param table   Table name, quoted by the caller.
+   * @param columns Column names, quoted by the caller.
+   * @param rows    Number of VALUES groups.
+   * @return SQL text.
+   */
+  std::string multi_row_insert_sql(std::string_view table,
+                                   std::span<const std::string> columns,
+                                   std::size_t rows);
+
+  /**
+   * @brief Approximate wire size of a bound value.
+   *
+   * @param v Value.
+   * @return Payload bytes for text and blobs, 8 for numbers.
+   */
+  std::size_t bound_size(const DbValue &v) noexcept;
+
+} // namespace vix::db
+
+#endif // VIX_DB_BULK_INSERT_HPP
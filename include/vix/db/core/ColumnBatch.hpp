@@ -0,0 +1,185 @@
+/**
+ *
+ *  @file ColumnBatch.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_COLUMN_BATCH_HPP
+#define VIX_DB_COLUMN_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <vix/db/core/Result.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief One column of a ColumnBatch, stored contiguously.
+   *
+   * Depending on kind(), values live in ints(), doubles(), or, for text
+   * and blobs, in one data buffer addressed by rows+1 offsets (row r
+   * spans [offsets[r], offsets[r+1])), as in Apache Arrow. A validity
+   * bitmap holds one bit per row, least significant bit first, set for
+   * non-NULL values; NULL rows hold 0 or an empty value.
+   */
+  class ColumnBuffer
+  {
+    Cell::Kind kind_;
+    std::size_t rows_ = 0;
+    std::vector<std::int64_t> ints_;
+    std::vector<double> doubles_;
+    std::vector<std::size_t> offsets_;
+    std::string data_;
+    std::vector<std::uint8_t> validity_;
+
+  public:
+    /**
+     * @brief Create an empty column.
+     *
+     * @param kind Representation of the values.
+     */
+    explicit ColumnBuffer(Cell::Kind kind) : kind_(kind) { offsets_.push_back(0); }
+
+    /// Representation of the values
+    Cell::Kind kind() const noexcept { return kind_; }
+
+    /// Number of rows
+    std::size_t size() const noexcept { return rows_; }
+
+    /// Whether a row is SQL NULL
+    bool isNull(std::size_t r) const noexcept
+    {
+      return (validity_[r >> 3] & (1u << (r & 7))) == 0;
+    }
+
+    /// Validity bitmap, one bit per row, set for non-NULL values
+    std::span<const std::uint8_t> validity() const noexcept { return validity_; }
+
+    /// Values of an Int64 column
+    std::span<const std::int64_t> ints() const noexcept { return ints_; }
+
+    /// Values of a Double column
+    std::span<const double> doubles() const noexcept { return doubles_; }
+
+    /// rows+1 offsets into data() of a Text or Blob column
+    std::span<const std::size_t> offsets() const noexcept { return offsets_; }
+
+    /// Concatenated bytes of a Text or Blob column
+    std::string_view data() const noexcept { return data_; }
+
+    /// Text of one row of a Text column
+    std::string_view text(std::size_t r) const noexcept
+    {
+      return std::string_view(data_).substr(offsets_[r], offsets_[r + 1] - offsets_[r]);
+    }
+
+    /// Bytes of one row of a Blob column
+    std::span<const std::byte> blob(std::size_t r) const noexcept
+    {
+      return std::as_bytes(std::span(data_.data() + offsets_[r], offsets_[r + 1] - offsets_[r]));
+    }
+
+    /**
+     * @brief Remove every row, keeping the capacity.
+     */
+    void clear() noexcept
+    {
+      rows_ = 0;
+      ints_.clear();
+      doubles_.clear();
+      offsets_.resize(1);
+      data_.clear();
+      validity_.clear();
+    }
+
+    /**
+     * @brief Reserve room for a number of rows.
+     *
+     * @param rows Expected row count.
+     */
+    void reserve(std::size_t rows);
+
+    /**
+     * @brief Append a decoded cell.
+     *
+     * @param c Cell of this column's kind.
+     */
+    void append(const Cell &c);
+  };
+
+  /**
+   * @brief Column-oriented buffers filled by ResultSet::fetchColumns().
+   *
+   * The batch is reused from one fetch to the next, so its buffers are
+   * allocated once per scan rather than once per batch.
+   *
+   * @code
+   * ColumnBatch batch{Cell::Kind::Int64, Cell::Kind::Double};
+   * while (rs->fetchColumns(batch, 4096) > 0)
+   * {
+   *   auto ids = batch[0].ints();
+   *   auto amounts = batch[1].doubles();
+   *   ...
+   * }
+   * @endcode
+   */
+  class ColumnBatch
+  {
+    std::vector<ColumnBuffer> columns_;
+    std::vector<Cell> cells_;
+    std::size_t rows_ = 0;
+
+  public:
+    /**
+     * @brief Create a batch for consecutive result columns.
+     *
+     * @param kinds Representation of each column, from the first one.
+     */
+    ColumnBatch(std::initializer_list<Cell::Kind> kinds);
+
+    /// Number of columns
+    std::size_t width() const noexcept { return columns_.size(); }
+
+    /// Number of rows of the last fetch
+    std::size_t rows() const noexcept { return rows_; }
+
+    /// Column at a position (zero-based)
+    const ColumnBuffer &operator[](std::size_t i) const noexcept { return columns_[i]; }
+
+    /**
+     * @brief Remove every row, keeping the capacity.
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Reserve room for a number of rows in every column.
+     *
+     * @param rows Expected row count.
+     */
+    void reserve(std::size_t rows);
+
+    /**
+     * @brief Append the current row of a result set.
+     *
+     * @param row Row decoded with a single ResultRow::decode() call.
+     */
+    void append(const ResultRow &row);
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_COLUMN_BATCH_HPP
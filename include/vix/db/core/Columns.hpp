@@ -0,0 +1,149 @@
+/**
+ *
+ *  @file Columns.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_COLUMNS_HPP
+#define VIX_DB_COLUMNS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vix/db/core/Errors.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief Description of one result column.
+   */
+  struct ColumnInfo
+  {
+    /// Column name or alias, as returned by the driver
+    std::string name;
+
+    /// Declared type name (e.g. "INTEGER", "VARCHAR"), empty if unknown
+    std::string type;
+
+    /// false only when the driver knows the column cannot hold NULL
+    bool nullable = true;
+  };
+
+  /**
+   * @brief Column metadata of a result set, with a name index.
+   *
+   * Built once per result set. Names are looked up in an open
+   * addressing hash table, so finding a column by name costs one hash
+   * of the name and, in practice, one comparison. When a name appears
+   * twice (e.g. a join without aliases) the first column wins.
+   */
+  class ColumnTable
+  {
+    std::vector<ColumnInfo> cols_;
+    std::vector<std::uint32_t> slots_; // column index + 1, 0 for empty
+    std::size_t mask_ = 0;
+
+    static std::size_t hash(std::string_view s) noexcept
+    {
+      std::uint64_t h = 14695981039346656037ull; // FNV-1a
+      for (unsigned char c : s)
+      {
+        h ^= c;
+        h *= 1099511628211ull;
+      }
+      return static_cast<std::size_t>(h ^ (h >> 32));
+    }
+
+  public:
+    ColumnTable() = default;
+
+    /**
+     * @brief Build the table and its name index.
+     *
+     * @param cols Columns in result order.
+     */
+    explicit ColumnTable(std::vector<ColumnInfo> cols) : cols_(std::move(cols))
+    {
+      std::size_t cap = 4;
+      while (cap < cols_.size() * 2)
+        cap *= 2;
+      slots_.assign(cap, 0);
+      mask_ = cap - 1;
+
+      for (std::size_t i = 0; i < cols_.size(); ++i)
+      {
+        std::size_t s = hash(cols_[i].name) & mask_;
+        while (slots_[s] != 0)
+        {
+          if (cols_[slots_[s] - 1].name == cols_[i].name)
+            break;
+          s = (s + 1) & mask_;
+        }
+        if (slots_[s] == 0)
+          slots_[s] = static_cast<std::uint32_t>(i + 1);
+      }
+    }
+
+    /// Number of columns
+    std::size_t size() const noexcept { return cols_.size(); }
+
+    /// Whether the result has no columns
+    bool empty() const noexcept { return cols_.empty(); }
+
+    /// Column at a position (zero-based)
+    const ColumnInfo &operator[](std::size_t i) const noexcept { return cols_[i]; }
+
+    auto begin() const noexcept { return cols_.begin(); }
+    auto end() const noexcept { return cols_.end(); }
+
+    /**
+     * @brief Find a column by name.
+     *
+     * @param name Column name or alias (case-sensitive).
+     * @return Zero-based index, or std::nullopt if absent.
+     */
+    std::optional<std::size_t> find(std::string_view name) const noexcept
+    {
+      if (slots_.empty())
+        return std::nullopt;
+
+      for (std::size_t s = hash(name) & mask_; slots_[s] != 0; s = (s + 1) & mask_)
+      {
+        const std::size_t i = slots_[s] - 1;
+        if (cols_[i].name == name)
+          return i;
+      }
+      return std::nullopt;
+    }
+
+    /**
+     * @brief Index of a column by name.
+     *
+     * @param name Column name or alias (case-sensitive).
+     * @return Zero-based index.
+     * @throws DBError if there is no such column.
+     */
+    std::size_t index(std::string_view name) const
+    {
+      if (const auto i = find(name))
+        return *i;
+      throw DBError("unknown column: " + std::string(name));
+    }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_COLUMNS_HPP
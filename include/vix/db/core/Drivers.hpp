@@ -19,9 +19,21 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <ranges>
+#include <span>
+#include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
 
+#include <vix/db/core/Batch.hpp>
+#include <vix/db/core/BulkInsert.hpp>
+#include <vix/db/core/Errors.hpp>
+#include <vix/db/core/Expected.hpp>
 #include <vix/db/core/Result.hpp>
+#include <vix/db/core/StatementCache.hpp>
 #include <vix/db/core/Value.hpp>
 
 namespace vix::db
@@ -33,53 +45,256 @@ namespace vix::db
    * Concrete database drivers (MySQL, SQLite, PostgreSQL, etc.) must implement
    * this interface.
    *
-   * The API is intentionally minimal and type-erased through DbValue to keep
-   * drivers simple and consistent.
+   * Drivers implement one typed bind entry point per SQL type; binding a
+   * DbValue and the convenience overloads are built on top of them, so
+   * binding a C++ value never goes through a std::variant.
    */
   struct Statement
   {
     virtual ~Statement() = default;
 
     /**
-     * @brief Bind a value to a positional parameter.
+     * @brief Bind a SQL NULL value.
      *
      * Indexing is driver-defined but is expected to be 1-based for SQL drivers
      * (e.g. ?, ?, ?) to match common database conventions.
      *
      * @param idx Parameter index.
+     */
+    virtual void bindNull(std::size_t idx) = 0;
+
+    /**
+     * @brief Bind a 64-bit integer.
+     *
+     * @param idx Parameter index.
+     * @param v Integer value.
+     */
+    virtual void bindInt64(std::size_t idx, std::int64_t v) = 0;
+
+    /**
+     * @brief Bind a double.
+     *
+     * @param idx Parameter index.
+     * @param v Floating-point value.
+     */
+    virtual void bindDouble(std::size_t idx, double v) = 0;
+
+    /**
+     * @brief Bind text without taking a copy.
+     *
+     * The caller keeps the buffer alive and unchanged until the statement
+     * has been run by exec() or query().
+     *
+     * @param idx Parameter index.
+     * @param v UTF-8 text, not copied.
+     */
+    virtual void bindText(std::size_t idx, std::string_view v) = 0;
+
+    /**
+     * @brief Bind binary data without taking a copy.
+     *
+     * Same buffer lifetime contract as bindText().
+     *
+     * @param idx Parameter index.
+     * @param v Bytes, not copied.
+     */
+    virtual void bindBlob(std::size_t idx, std::span<const std::byte> v) = 0;
+
+    /**
+     * @brief Bind text, the driver keeping its own copy.
+     *
+     * @param idx Parameter index.
+     * @param v UTF-8 text, may be released right after the call.
+     */
+    virtual void bindTextCopy(std::size_t idx, std::string_view v) = 0;
+
+    /**
+     * @brief Bind binary data, the driver keeping its own copy.
+     *
+     * @param idx Parameter index.
+     * @param v Bytes, may be released right after the call.
+     */
+    virtual void bindBlobCopy(std::size_t idx, std::span<const std::byte> v) = 0;
+
+    /**
+     * @brief Bind a timestamp.
+     *
+     * The default binds the text of to_string(); drivers with a native
+     * temporal type override it.
+     *
+     * @param idx Parameter index.
+     * @param v Timestamp, UTC.
+     */
+    virtual void bindTimestamp(std::size_t idx, Timestamp v) { bindTextCopy(idx, to_string(v)); }
+
+    /**
+     * @brief Bind a calendar date.
+     *
+     * The default binds the text of to_string().
+     *
+     * @param idx Parameter index.
+     * @param v Date.
+     */
+    virtual void bindDate(std::size_t idx, Date v) { bindTextCopy(idx, to_string(v)); }
+
+    /**
+     * @brief Bind an exact decimal.
+     *
+     * The default binds the text of to_string().
+     *
+     * @param idx Parameter index.
+     * @param v Decimal.
+     */
+    virtual void bindDecimal(std::size_t idx, const Decimal &v) { bindTextCopy(idx, to_string(v)); }
+
+    /**
+     * @brief Bind a UUID.
+     *
+     * The default binds its 16 bytes as a blob.
+     *
+     * @param idx Parameter index.
+     * @param v UUID.
+     */
+    virtual void bindUuid(std::size_t idx, const Uuid &v)
+    {
+      bindBlobCopy(idx, std::as_bytes(std::span(v.bytes)));
+    }
+
+    /**
+     * @brief Bind a value to a positional parameter.
+     *
+     * Dispatches to the typed entry point matching the value; text and
+     * blobs are copied.
+     *
+     * @param idx Parameter index.
      * @param v Database value wrapper.
      */
-    virtual void bind(std::size_t idx, const DbValue &v) = 0;
+    void bind(std::size_t idx, const DbValue &v)
+    {
+      std::visit(
+          [&](const auto &x)
+          {
+            using T = std::decay_t<decltype(x)>;
 
-    /// Convenience overloads for common C++ types
-    void bind(std::size_t idx, int v) { bind(idx, static_cast<std::int64_t>(v)); }
-    void bind(std::size_t idx, unsigned v) { bind(idx, static_cast<std::int64_t>(v)); }
-    void bind(std::size_t idx, std::int64_t v) { bind(idx, i64(v)); }
-    void bind(std::size_t idx, std::uint64_t v) { bind(idx, static_cast<std::int64_t>(v)); }
-    void bind(std::size_t idx, double v) { bind(idx, f64(v)); }
-    void bind(std::size_t idx, bool v) { bind(idx, b(v)); }
-    void bind(std::size_t idx, std::string v) { bind(idx, str(std::move(v))); }
-    void bind(std::size_t idx, const char *v)
+            if constexpr (std::is_same_v<T, std::nullptr_t>)
+              bindNull(idx);
+            else if constexpr (std::is_same_v<T, bool>)
+              bindInt64(idx, x ? 1 : 0);
+            else if constexpr (std::is_same_v<T, std::int64_t>)
+              bindInt64(idx, x);
+            else if constexpr (std::is_same_v<T, double>)
+              bindDouble(idx, x);
+            else if constexpr (std::is_same_v<T, std::string>)
+              bindTextCopy(idx, x);
+            else if constexpr (std::is_same_v<T, Timestamp>)
+              bindTimestamp(idx, x);
+            else if constexpr (std::is_same_v<T, Date>)
+              bindDate(idx, x);
+            else if constexpr (std::is_same_v<T, Decimal>)
+              bindDecimal(idx, x);
+            else if constexpr (std::is_same_v<T, Uuid>)
+              bindUuid(idx, x);
+            else
+              bindBlobCopy(idx, std::as_bytes(std::span(x.bytes)));
+          },
+          v);
+    }
+
+    /**
+     * @brief Bind a value view to a positional parameter.
+     *
+     * Dispatches to the typed entry point matching the value; text and
+     * blobs are not copied, see bindText().
+     *
+     * @param idx Parameter index.
+     * @param v Non-owning value.
+     */
+    void bind(std::size_t idx, const DbValueView &v)
     {
-      bind(idx, str(std::string(v ? v : "")));
+      std::visit(
+          [&](const auto &x)
+          {
+            using T = std::decay_t<decltype(x)>;
+
+            if constexpr (std::is_same_v<T, std::nullptr_t>)
+              bindNull(idx);
+            else if constexpr (std::is_same_v<T, bool>)
+              bindInt64(idx, x ? 1 : 0);
+            else if constexpr (std::is_same_v<T, std::int64_t>)
+              bindInt64(idx, x);
+            else if constexpr (std::is_same_v<T, double>)
+              bindDouble(idx, x);
+            else if constexpr (std::is_same_v<T, std::string_view>)
+              bindText(idx, x);
+            else if constexpr (std::is_same_v<T, Timestamp>)
+              bindTimestamp(idx, x);
+            else if constexpr (std::is_same_v<T, Date>)
+              bindDate(idx, x);
+            else if constexpr (std::is_same_v<T, Decimal>)
+              bindDecimal(idx, x);
+            else if constexpr (std::is_same_v<T, Uuid>)
+              bindUuid(idx, x);
+            else
+              bindBlob(idx, x);
+          },
+          v);
     }
 
     /**
-     * @brief Bind a SQL NULL value.
+     * @brief Bind a value held in a memory resource, without copying it.
      *
      * @param idx Parameter index.
+     * @param v Value, kept alive until the statement has run.
      */
-    void bindNull(std::size_t idx) { bind(idx, null()); }
+    void bind(std::size_t idx, const pmr::DbValue &v) { bind(idx, pmr::view(v)); }
+
+    /// Convenience overloads for common C++ types
+    void bind(std::size_t idx, int v) { bindInt64(idx, v); }
+    void bind(std::size_t idx, unsigned v) { bindInt64(idx, static_cast<std::int64_t>(v)); }
+    void bind(std::size_t idx, std::int64_t v) { bindInt64(idx, v); }
+    void bind(std::size_t idx, std::uint64_t v) { bindInt64(idx, static_cast<std::int64_t>(v)); }
+    void bind(std::size_t idx, double v) { bindDouble(idx, v); }
+    void bind(std::size_t idx, bool v) { bindInt64(idx, v ? 1 : 0); }
+    void bind(std::size_t idx, const std::string &v) { bindTextCopy(idx, v); }
+    void bind(std::size_t idx, const char *v) { bindTextCopy(idx, v ? v : ""); }
+    void bind(std::size_t idx, Timestamp v) { bindTimestamp(idx, v); }
+    void bind(std::size_t idx, Date v) { bindDate(idx, v); }
+    void bind(std::size_t idx, const Decimal &v) { bindDecimal(idx, v); }
+    void bind(std::size_t idx, const Uuid &v) { bindUuid(idx, v); }
+
+    /// Non-owning overloads, see bindText() and bindBlob()
+    void bind(std::size_t idx, std::string_view v) { bindText(idx, v); }
+    void bind(std::size_t idx, std::span<const std::byte> v) { bindBlob(idx, v); }
 
     /**
      * @brief Execute a query and return a result set.
      *
-     * This is typically used for SELECT statements.
+     * This is typically used for SELECT statements. The statement stays
+     * usable: once the result set is destroyed it can be bound and
+     * queried again without being prepared anew. Executing it again
+     * while a result set is still open ends that result set.
      *
      * @return Owning pointer to a ResultSet.
      */
     virtual std::unique_ptr<ResultSet> query() = 0;
 
+    /**
+     * @brief Stream the rows of the following queries.
+     *
+     * With a non-zero fetch size, query() returns a result set that
+     * holds at most that many rows client-side and reads the rest from
+     * the server as next() advances, so memory and time to first row do
+     * not grow with the result. Until such a result set is read to the
+     * end or destroyed, the connection cannot run other statements, and
+     * destroying it early still reads and discards the remaining rows.
+     *
+     * The default does nothing: it suits drivers that already produce
+     * rows one step at a time, such as SQLite.
+     *
+     * @param rows Rows held client-side, 0 for the driver's default.
+     */
+    virtual void setFetchSize(std::size_t /*rows*/) {}
+
     /**
      * @brief Execute a statement without returning rows.
      *
@@ -88,6 +303,106 @@ namespace vix::db
      * @return Number of affected rows, if supported by the driver.
      */
     virtual std::uint64_t exec() = 0;
+
+    /**
+     * @brief Execute a statement, reporting expected failures by value.
+     *
+     * Same as exec(), except that a failure with a DbErrorCode other
+     * than Other (duplicate key, busy, deadlock, timeout, lost
+     * connection) is returned instead of thrown, so upserts and retry
+     * loops do not pay for unwinding. Other failures still throw.
+     *
+     * The default catches what exec() throws; drivers override it to
+     * classify the backend error without raising.
+     *
+     * @return Number of affected rows, or the failure.
+     */
+    virtual Expected<std::uint64_t> tryExec()
+    {
+      try
+      {
+        return exec();
+      }
+      catch (const ConnectionLost &e)
+      {
+        return ErrorInfo{DbErrorCode::ConnectionLost, 0, {}, e.what()};
+      }
+    }
+
+    /**
+     * @brief Execute a query, reporting expected failures by value.
+     *
+     * Same as query(), with the failures of tryExec() returned. Drivers
+     * that run the statement lazily fetch the first row here, so a lock
+     * conflict is reported by this call rather than by the first
+     * ResultSet::next(); later rows still throw.
+     *
+     * @return Result set, or the failure.
+     */
+    virtual Expected<std::unique_ptr<ResultSet>> tryQuery()
+    {
+      try
+      {
+        return query();
+      }
+      catch (const ConnectionLost &e)
+      {
+        return ErrorInfo{DbErrorCode::ConnectionLost, 0, {}, e.what()};
+      }
+    }
+
+    /**
+     * @brief Execute the statement once per parameter row.
+     *
+     * Drivers run the whole batch in as few round trips as they can,
+     * atomically when the backend allows it. The default binds and
+     * executes each row in turn.
+     *
+     * Each count is the number of rows affected by one execution: one
+     * count per parameter row when rows are executed one by one, one
+     * per chunk when the driver folds several rows into a single
+     * statement (such as a multi-row INSERT).
+     *
+     * @param batch Parameter rows, bound to placeholders 1..width().
+     * @return Affected row counts, in execution order.
+     */
+    virtual std::vector<std::uint64_t> execBatch(const ParamBatch &batch)
+    {
+      std::vector<std::uint64_t> counts;
+      counts.reserve(batch.size());
+      for (std::size_t r = 0; r < batch.size(); ++r)
+      {
+        const auto row = batch.row(r);
+        for (std::size_t i = 0; i < row.size(); ++i)
+          bind(i + 1, row[i]);
+        counts.push_back(exec());
+      }
+      return counts;
+    }
+
+    /**
+     * @brief Execute the statement once per tuple of a range.
+     *
+     * @param rows Range of std::tuple (or pair) holding one value per
+     *             placeholder.
+     * @return Affected row counts, see execBatch(const ParamBatch&).
+     */
+    template <std::ranges::input_range R>
+      requires(!std::is_same_v<std::remove_cvref_t<R>, ParamBatch>)
+    std::vector<std::uint64_t> execBatch(const R &rows)
+    {
+      using Row = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+
+      ParamBatch batch(std::tuple_size_v<Row>);
+      if constexpr (std::ranges::sized_range<R>)
+        batch.reserve(std::ranges::size(rows));
+
+      for (const auto &row : rows)
+        std::apply([&](const auto &...v)
+                   { batch.add(v...); },
+                   row);
+      return execBatch(batch);
+    }
   };
 
   /**
@@ -138,6 +453,78 @@ namespace vix::db
      * @return true if the connection is usable.
      */
     virtual bool ping() { return true; }
+
+    /**
+     * @brief Counters of the connection's prepared statement cache.
+     *
+     * Drivers without a statement cache report zeros.
+     *
+     * @return Cache statistics.
+     */
+    virtual StatementCacheStats statementCacheStats() const { return {}; }
+
+    /**
+     * @brief Limits bounding one statement generated by insertMany().
+     *
+     * @return Placeholder and size limits of the backend.
+     */
+    virtual InsertLimits insertLimits() { return {}; }
+
+    /**
+     * @brief Character quoting identifiers in generated SQL.
+     *
+     * @return '"' by default (ANSI SQL).
+     */
+    virtual char identifierQuote() const { return '"'; }
+
+    /**
+     * @brief Insert many rows with multi-row INSERT statements.
+     *
+     * Rows are split into chunks bounded by insertLimits(), each chunk
+     * sent as one "INSERT INTO table (columns) VALUES (...), (...)".
+     * Chunks other than the largest one use a power of two row count,
+     * so a few statement shapes cover any row count and stay in the
+     * statement cache.
+     *
+     * Chunks are separate statements: run the call inside a Transaction
+     * to make the whole insert atomic.
+     *
+     * @param table   Table name, optionally schema-qualified.
+     * @param columns Column names, one per value of a row.
+     * @param rows    Rows to insert, width() must match columns.
+     * @return Number of inserted rows reported by the driver.
+     * @throws DBError on width mismatch or driver failure.
+     */
+    std::uint64_t insertMany(std::string_view table,
+                             const std::vector<std::string> &columns,
+                             const ParamBatch &rows);
+
+    /**
+     * @brief Insert a range of tuples with multi-row INSERT statements.
+     *
+     * @param table   Table name, optionally schema-qualified.
+     * @param columns Column names, one per tuple element.
+     * @param rows    Range of std::tuple (or pair).
+     * @return Number of inserted rows reported by the driver.
+     */
+    template <std::ranges::input_range R>
+      requires(!std::is_same_v<std::remove_cvref_t<R>, ParamBatch>)
+    std::uint64_t insertMany(std::string_view table,
+                             const std::vector<std::string> &columns,
+                             const R &rows)
+    {
+      using Row = std::remove_cvref_t<std::ranges::range_value_t<R>>;
+
+      ParamBatch batch(std::tuple_size_v<Row>);
+      if constexpr (std::ranges::sized_range<R>)
+        batch.reserve(std::ranges::size(rows));
+
+      for (const auto &row : rows)
+        std::apply([&](const auto &...v)
+                   { batch.add(v...); },
+                   row);
+      return insertMany(table, columns, batch);
+    }
   };
 
   /// Shared pointer alias for database connections
@@ -17,6 +17,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 namespace vix::db
 {
@@ -79,6 +80,155 @@ namespace vix::db
     using DBError::DBError;
   };
 
+  /**
+   * @brief Error indicating that the connection to the server is gone.
+   *
+   * Drivers throw this instead of a plain DBError when the failure is
+   * about the connection itself (server gone away, lost during a query,
+   * network error) rather than about the statement. The connection must
+   * not be reused; ConnectionPool::withConnection() retries on a fresh one.
+   */
+  struct ConnectionLost : DBError
+  {
+    /**
+     * @brief Construct a connection lost error.
+     *
+     * @param message Human-readable error description.
+     */
+    using DBError::DBError;
+  };
+
+  /**
+   * @brief Error raised when a pooled connection cannot be obtained in time.
+   *
+   * Thrown by ConnectionPool::acquire() when the caller's deadline (or
+   * PoolConfig::acquire_timeout) expires before a connection is handed
+   * over. It lets callers tell pool starvation apart from query failures.
+   */
+  struct PoolTimeout : DBError
+  {
+    /**
+     * @brief Construct a pool timeout error.
+     *
+     * @param message Human-readable error description.
+     */
+    using DBError::DBError;
+  };
+
+  /**
+   * @brief Failure classes a caller is expected to handle.
+   *
+   * Returned by the non-throwing statement API (Statement::tryExec(),
+   * Statement::tryQuery()). Anything outside these classes is a bug in
+   * the query or its use and is still thrown as DBError.
+   */
+  enum class DbErrorCode
+  {
+    DuplicateKey,        ///< unique or primary key violation
+    ConstraintViolation, ///< other integrity constraint (foreign key, NOT NULL, CHECK)
+    Busy,                ///< database locked by another connection
+    Deadlock,            ///< transaction chosen as a deadlock or serialization victim
+    Timeout,             ///< lock wait or statement time limit exceeded
+    ConnectionLost,      ///< connection unusable, see ConnectionLost
+    Other,               ///< failure outside the classes above
+  };
+
+  /// Name of an error code, e.g. "duplicate key"
+  constexpr const char *to_string(DbErrorCode code) noexcept
+  {
+    switch (code)
+    {
+    case DbErrorCode::DuplicateKey:
+      return "duplicate key";
+    case DbErrorCode::ConstraintViolation:
+      return "constraint violation";
+    case DbErrorCode::Busy:
+      return "busy";
+    case DbErrorCode::Deadlock:
+      return "deadlock";
+    case DbErrorCode::Timeout:
+      return "timeout";
+    case DbErrorCode::ConnectionLost:
+      return "connection lost";
+    default:
+      return "other";
+    }
+  }
+
+  /**
+   * @brief Whether running the transaction again may succeed.
+   *
+   * True for Busy, Deadlock and Timeout: the failure comes from
+   * concurrent work, not from the statement.
+   */
+  constexpr bool is_transient(DbErrorCode code) noexcept
+  {
+    return code == DbErrorCode::Busy || code == DbErrorCode::Deadlock ||
+           code == DbErrorCode::Timeout;
+  }
+
+  /**
+   * @brief Classify a five-character SQLSTATE.
+   *
+   * Class 23 (integrity constraint), 40 (transaction rollback), 08
+   * (connection exception), HYT00/HYT01 and 57014 (timeouts, query
+   * cancelled). 23505 is the standard unique violation; servers that
+   * report every integrity error as 23000, such as MySQL, need their
+   * native code to tell a duplicate key apart.
+   *
+   * @param state SQLSTATE, e.g. "23505".
+   * @return Matching code, DbErrorCode::Other if none.
+   */
+  constexpr DbErrorCode classify_sqlstate(std::string_view state) noexcept
+  {
+    if (state.size() != 5)
+      return DbErrorCode::Other;
+    const std::string_view cls = state.substr(0, 2);
+    if (state == "23505")
+      return DbErrorCode::DuplicateKey;
+    if (cls == "23")
+      return DbErrorCode::ConstraintViolation;
+    if (cls == "40")
+      return DbErrorCode::Deadlock;
+    if (cls == "08")
+      return DbErrorCode::ConnectionLost;
+    if (state == "HYT00" || state == "HYT01" || state == "57014")
+      return DbErrorCode::Timeout;
+    return DbErrorCode::Other;
+  }
+
+  /**
+   * @brief Structured description of a failed statement.
+   */
+  struct ErrorInfo
+  {
+    /// Failure class
+    DbErrorCode code = DbErrorCode::Other;
+
+    /// Backend error number (SQLite extended result code, MySQL error number)
+    int native = 0;
+
+    /// SQLSTATE reported by the backend, empty when it has none (SQLite)
+    std::string sqlstate;
+
+    /// Human-readable message, prefixed like the matching exception
+    std::string message;
+  };
+
+  /**
+   * @brief Throw the exception the throwing API would have raised.
+   *
+   * ConnectionLost for DbErrorCode::ConnectionLost, DBError otherwise.
+   *
+   * @param e Failure to report.
+   */
+  [[noreturn]] inline void raise(const ErrorInfo &e)
+  {
+    if (e.code == DbErrorCode::ConnectionLost)
+      throw ConnectionLost(e.message);
+    throw DBError(e.message);
+  }
+
 } // namespace vix::db
 
 #endif // VIX_DB_ERRORS_HPP
@@ -0,0 +1,106 @@
+/**
+ *
+ *  @file Expected.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_EXPECTED_HPP
+#define VIX_DB_EXPECTED_HPP
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <vix/db/core/Errors.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief Value or ErrorInfo, in the manner of C++23 std::expected.
+   *
+   * Returned by the non-throwing statement API so that expected
+   * failures (duplicate keys, lock conflicts) are plain return values:
+   *
+   * @code
+   * auto r = st->tryExec();
+   * if (!r && r.error().code == DbErrorCode::DuplicateKey)
+   *   return update(id);
+   * std::uint64_t changed = r.value(); // throws on any other failure
+   * @endcode
+   *
+   * @tparam T Value type, must differ from ErrorInfo.
+   */
+  template <typename T>
+  class Expected
+  {
+    static_assert(!std::is_same_v<T, ErrorInfo>, "Expected<ErrorInfo> is ambiguous");
+
+    std::variant<T, ErrorInfo> v_;
+
+  public:
+    /// Success holding a value
+    Expected(T value) : v_(std::in_place_index<0>, std::move(value)) {}
+
+    /// Failure
+    Expected(ErrorInfo error) : v_(std::in_place_index<1>, std::move(error)) {}
+
+    /// Whether a value is held
+    bool has_value() const noexcept { return v_.index() == 0; }
+    explicit operator bool() const noexcept { return has_value(); }
+
+    /**
+     * @brief Held value.
+     *
+     * @throws DBError (ConnectionLost for a lost connection) on failure,
+     *         see raise().
+     */
+    T &value() &
+    {
+      if (!has_value())
+        raise(error());
+      return *std::get_if<0>(&v_);
+    }
+
+    const T &value() const &
+    {
+      if (!has_value())
+        raise(error());
+      return *std::get_if<0>(&v_);
+    }
+
+    T &&value() &&
+    {
+      if (!has_value())
+        raise(error());
+      return std::move(*std::get_if<0>(&v_));
+    }
+
+    /// Held value, undefined on failure
+    T &operator*() & noexcept { return *std::get_if<0>(&v_); }
+    const T &operator*() const & noexcept { return *std::get_if<0>(&v_); }
+    T &&operator*() && noexcept { return std::move(*std::get_if<0>(&v_)); }
+    T *operator->() noexcept { return std::get_if<0>(&v_); }
+    const T *operator->() const noexcept { return std::get_if<0>(&v_); }
+
+    /// Failure description, undefined on success
+    const ErrorInfo &error() const noexcept { return *std::get_if<1>(&v_); }
+
+    /// Held value, or fallback on failure
+    template <typename U>
+    T value_or(U &&fallback) const &
+    {
+      return has_value() ? **this : static_cast<T>(std::forward<U>(fallback));
+    }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_EXPECTED_HPP
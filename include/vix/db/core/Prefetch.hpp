@@ -0,0 +1,53 @@
+/**
+ *
+ *  @file Prefetch.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_PREFETCH_HPP
+#define VIX_DB_PREFETCH_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <vix/db/core/Result.hpp>
+
+namespace vix::db
+{
+  /// Default number of rows a prefetching result set reads per batch
+  inline constexpr std::size_t kDefaultPrefetchRows = 256;
+
+  /**
+   * @brief Read a result set ahead of its consumer on a helper thread.
+   *
+   * The helper thread steps the source result set and copies batches of
+   * rows into owned storage, keeping at most two batches ready: while
+   * the consumer works through one batch, the next one is being read
+   * from the driver. Useful when the per-row work is slow enough for
+   * the driver I/O to hide behind it.
+   *
+   * The returned result set owns the source, which must not be used
+   * any more, and the source's connection must not be used until the
+   * returned result set is destroyed. Rows are copied as DbValue, so
+   * views returned by the rows stay valid until the next call to
+   * next(), as with any result set. A driver error is rethrown by the
+   * consumer's next() once the rows read before it are consumed.
+   *
+   * @param source     Result set to read ahead.
+   * @param batch_rows Rows per batch.
+   * @return Result set yielding the rows of source.
+   */
+  std::unique_ptr<ResultSet> prefetch(std::unique_ptr<ResultSet> source,
+                                      std::size_t batch_rows = kDefaultPrefetchRows);
+
+} // namespace vix::db
+
+#endif // VIX_DB_PREFETCH_HPP
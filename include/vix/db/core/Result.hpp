@@ -15,12 +15,172 @@
 #ifndef VIX_DB_RESULT_HPP
 #define VIX_DB_RESULT_HPP
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vix/db/core/Columns.hpp>
+#include <vix/db/core/Value.hpp>
 
 namespace vix::db
 {
+  namespace detail
+  {
+    template <typename T>
+    struct is_optional : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_optional<std::optional<T>> : std::true_type
+    {
+    };
+
+    template <typename>
+    inline constexpr bool dependent_false = false;
+  } // namespace detail
+
+  /**
+   * @brief One column of a row decoded by ResultRow::decode().
+   *
+   * The caller sets kind, the driver fills null and the member that
+   * kind selects. text and bytes point into the driver's row buffer
+   * and stay valid until the next call to ResultSet::next().
+   */
+  struct Cell
+  {
+    /// Representation requested from the driver
+    enum class Kind : std::uint8_t
+    {
+      Int64,
+      Double,
+      Text,
+      Blob
+    };
+
+    Kind kind = Kind::Int64;
+    bool null = false;
+    std::int64_t i = 0;
+    double d = 0.0;
+    std::string_view text;
+    std::span<const std::byte> bytes;
+  };
+
+  namespace detail
+  {
+    template <typename T>
+    struct is_tuple : std::false_type
+    {
+    };
+
+    template <typename... Ts>
+    struct is_tuple<std::tuple<Ts...>> : std::true_type
+    {
+    };
+
+    template <typename A, typename B>
+    struct is_tuple<std::pair<A, B>> : std::true_type
+    {
+    };
+
+    template <typename P>
+    struct member_type;
+
+    template <typename C, typename M>
+    struct member_type<M C::*>
+    {
+      using type = M;
+    };
+
+    /// Type of the member a pointer-to-member designates
+    template <typename P>
+    using member_type_t = typename member_type<std::remove_cv_t<P>>::type;
+
+    /// Types read through their ResultRow getter, as their stored kind
+    /// varies: integers, Julian days, text or binary forms
+    template <typename T>
+    constexpr bool is_typed_value()
+    {
+      if constexpr (is_optional<T>::value)
+        return is_typed_value<typename T::value_type>();
+      else
+        return std::is_same_v<T, Timestamp> || std::is_same_v<T, Date> ||
+               std::is_same_v<T, Decimal> || std::is_same_v<T, Uuid>;
+    }
+
+    /// Cell kind a C++ type is decoded from
+    template <typename T>
+    constexpr Cell::Kind cell_kind()
+    {
+      if constexpr (is_optional<T>::value)
+        return cell_kind<typename T::value_type>();
+      else if constexpr (is_typed_value<T>())
+        return Cell::Kind::Text; // not decoded, see ResultRow::as()
+      else if constexpr (std::is_integral_v<T>)
+        return Cell::Kind::Int64;
+      else if constexpr (std::is_floating_point_v<T>)
+        return Cell::Kind::Double;
+      else if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+        return Cell::Kind::Text;
+      else if constexpr (std::is_same_v<T, std::span<const std::byte>> || std::is_same_v<T, Blob>)
+        return Cell::Kind::Blob;
+      else
+        static_assert(dependent_false<T>, "ResultRow::as: unsupported column type");
+    }
+
+    /// Convert a decoded cell, SQL NULL giving a value-initialized T
+    template <typename T>
+    T cell_to(const Cell &c)
+    {
+      if constexpr (is_optional<T>::value)
+      {
+        if (c.null)
+          return std::nullopt;
+        return T{cell_to<typename T::value_type>(c)};
+      }
+      else if constexpr (std::is_same_v<T, bool>)
+        return c.i != 0;
+      else if constexpr (std::is_integral_v<T>)
+        return static_cast<T>(c.i);
+      else if constexpr (std::is_floating_point_v<T>)
+        return static_cast<T>(c.d);
+      else if constexpr (std::is_same_v<T, std::string>)
+        return std::string(c.text);
+      else if constexpr (std::is_same_v<T, std::string_view>)
+        return c.text;
+      else if constexpr (std::is_same_v<T, std::span<const std::byte>>)
+        return c.bytes;
+      else
+      {
+        const auto *p = reinterpret_cast<const std::uint8_t *>(c.bytes.data());
+        return Blob{std::vector<std::uint8_t>(p, p + c.bytes.size())};
+      }
+    }
+  } // namespace detail
+
+  class ColumnBatch;
+  class RowBuffer;
+  struct MaterializeOptions;
+
+  /**
+   * @brief Struct types decodable by ResultRow::as().
+   *
+   * Declared with VIX_DB_FIELDS, which lists the members read from
+   * consecutive columns.
+   */
+  template <typename T>
+  concept MappedRow = requires { vix_db_fields(static_cast<const T *>(nullptr)); };
+
   /**
    * @brief Represents a single row in a database result set.
    *
@@ -50,6 +210,28 @@ namespace vix::db
      */
     virtual std::string getString(std::size_t i) const = 0;
 
+    /**
+     * @brief Retrieve the column text without copying it.
+     *
+     * The view points into the driver's row buffer and stays valid
+     * until the next call to ResultSet::next(). Reading the same
+     * column through another accessor may invalidate it.
+     *
+     * @param i Column index (zero-based).
+     * @return Column value as text, empty for SQL NULL.
+     */
+    virtual std::string_view getStringView(std::size_t i) const = 0;
+
+    /**
+     * @brief Retrieve the column bytes without copying them.
+     *
+     * Same lifetime as getStringView().
+     *
+     * @param i Column index (zero-based).
+     * @return Column value as raw bytes, empty for SQL NULL.
+     */
+    virtual std::span<const std::byte> getBlob(std::size_t i) const = 0;
+
     /**
      * @brief Retrieve the column value as a 64-bit integer.
      *
@@ -66,6 +248,219 @@ namespace vix::db
      */
     virtual double getDouble(std::size_t i) const = 0;
 
+    /**
+     * @brief Retrieve the column value as a timestamp.
+     *
+     * The default decodes getCell(): an integer as microseconds since
+     * the epoch, a real as a Julian day, text in ISO form. Drivers with
+     * a binary temporal protocol override it.
+     *
+     * @param i Column index (zero-based).
+     * @return Column value, the epoch for SQL NULL.
+     * @throws DBError if the value is not a timestamp.
+     */
+    virtual Timestamp getTimestamp(std::size_t i) const;
+
+    /**
+     * @brief Retrieve the column value as a date.
+     *
+     * Same decoding as getTimestamp(), an integer counting days.
+     *
+     * @param i Column index (zero-based).
+     * @return Column value, 1970-01-01 for SQL NULL.
+     * @throws DBError if the value is not a date.
+     */
+    virtual Date getDate(std::size_t i) const;
+
+    /**
+     * @brief Retrieve the column value as an exact decimal.
+     *
+     * Decodes text, integers, reals and the binary form of to_bytes().
+     *
+     * @param i Column index (zero-based).
+     * @return Column value, 0 for SQL NULL.
+     * @throws DBError if the value is not a decimal.
+     */
+    virtual Decimal getDecimal(std::size_t i) const;
+
+    /**
+     * @brief Retrieve the column value as a UUID.
+     *
+     * Decodes 16 raw bytes or the 36-character text form.
+     *
+     * @param i Column index (zero-based).
+     * @return Column value, the nil UUID for SQL NULL.
+     * @throws DBError if the value is not a UUID.
+     */
+    virtual Uuid getUuid(std::size_t i) const;
+
+    /**
+     * @brief Retrieve the column value as a DbValue.
+     *
+     * Drivers override this to map the column's runtime type; the
+     * default reads every non-NULL value as text.
+     *
+     * @param i Column index (zero-based).
+     * @return Column value, or a null DbValue for SQL NULL.
+     */
+    virtual DbValue getValue(std::size_t i) const
+    {
+      return isNull(i) ? null() : str(getString(i));
+    }
+
+    /**
+     * @brief Retrieve the column value into a memory resource.
+     *
+     * Same runtime type as getValue(), with text and bytes allocated
+     * from mr, so rows kept for a request can live in its arena.
+     *
+     * @param i  Column index (zero-based).
+     * @param mr Resource providing the text or byte storage.
+     * @return Column value, or a null value for SQL NULL.
+     */
+    pmr::DbValue getValueIn(std::size_t i, std::pmr::memory_resource *mr) const
+    {
+      const Cell c = getCell(i);
+      if (c.null)
+        return nullptr;
+
+      switch (c.kind)
+      {
+      case Cell::Kind::Int64:
+        return c.i;
+      case Cell::Kind::Double:
+        return c.d;
+      case Cell::Kind::Text:
+        return pmr::value(c.text, mr);
+      case Cell::Kind::Blob:
+        break;
+      }
+      return pmr::value(c.bytes, mr);
+    }
+
+    /**
+     * @brief Decode a column in the representation getValue() would use.
+     *
+     * Sets kind from the value's runtime type, without copying text or
+     * bytes: they have the lifetime of getStringView(). The default
+     * reads every non-NULL value as text, like getValue().
+     *
+     * @param i Column index (zero-based).
+     * @return Decoded cell, null set for SQL NULL.
+     */
+    virtual Cell getCell(std::size_t i) const
+    {
+      Cell c;
+      c.kind = Cell::Kind::Text;
+      c.null = isNull(i);
+      if (!c.null)
+        c.text = getStringView(i);
+      return c;
+    }
+
+    /**
+     * @brief Decode consecutive columns in a single call.
+     *
+     * Drivers override this to read every cell straight from their
+     * row buffer; the default goes through the per-column getters.
+     *
+     * @param cells One cell per column, kind set by the caller.
+     * @param first Index of the column decoded into cells[0].
+     */
+    virtual void decode(std::span<Cell> cells, std::size_t first = 0) const
+    {
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        Cell &c = cells[k];
+        const std::size_t i = first + k;
+        c.null = isNull(i);
+        if (c.null)
+          continue;
+
+        switch (c.kind)
+        {
+        case Cell::Kind::Int64:
+          c.i = getInt64(i);
+          break;
+        case Cell::Kind::Double:
+          c.d = getDouble(i);
+          break;
+        case Cell::Kind::Text:
+          c.text = getStringView(i);
+          break;
+        case Cell::Kind::Blob:
+          c.bytes = getBlob(i);
+          break;
+        }
+      }
+    }
+
+    /**
+     * @brief Decode the row into a tuple or a mapped struct.
+     *
+     * The layout is fixed at compile time and the driver fills it with
+     * one decode() call. Element types are those of get(std::size_t),
+     * except DbValue, plus Blob; Timestamp, Date, Decimal and Uuid
+     * columns are read with their getters instead. std::string_view and
+     * std::span<const std::byte> elements point into the row buffer.
+     *
+     * @code
+     * auto [id, name, score] = rs->as<std::tuple<std::int64_t, std::string_view, double>>();
+     *
+     * struct User { std::int64_t id; std::string name; };
+     * VIX_DB_FIELDS(User, id, name)
+     * User u = rs->row().as<User>();
+     * @endcode
+     *
+     * @tparam T std::tuple, std::pair or a type declared with VIX_DB_FIELDS.
+     * @return The decoded row.
+     */
+    template <typename T>
+    T as() const
+    {
+      if constexpr (detail::is_tuple<T>::value)
+      {
+        return [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+          std::array<Cell, sizeof...(I)> cells{};
+          ((cells[I].kind = detail::cell_kind<std::tuple_element_t<I, T>>()), ...);
+          decodeAs<std::tuple_element_t<I, T>...>(cells);
+          return T{column<std::tuple_element_t<I, T>>(cells[I], I)...};
+        }(std::make_index_sequence<std::tuple_size_v<T>>{});
+      }
+      else if constexpr (MappedRow<T>)
+      {
+        constexpr auto fields = vix_db_fields(static_cast<const T *>(nullptr));
+        return [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+          using Fields = decltype(fields);
+          std::array<Cell, sizeof...(I)> cells{};
+          ((cells[I].kind = detail::cell_kind<
+                detail::member_type_t<std::tuple_element_t<I, Fields>>>()),
+           ...);
+          decodeAs<detail::member_type_t<std::tuple_element_t<I, Fields>>...>(cells);
+
+          T out{};
+          ((out.*std::get<I>(fields) =
+                column<detail::member_type_t<std::tuple_element_t<I, Fields>>>(cells[I], I)),
+           ...);
+          return out;
+        }(std::make_index_sequence<std::tuple_size_v<decltype(fields)>>{});
+      }
+      else
+        static_assert(detail::dependent_false<T>,
+                      "ResultRow::as: expected a tuple or a VIX_DB_FIELDS struct");
+    }
+
+    /**
+     * @brief Column metadata of the result this row belongs to.
+     *
+     * Loaded by the driver on first use, then shared by every row.
+     *
+     * @return Column table.
+     */
+    virtual const ColumnTable &columns() const = 0;
+
     /**
      * @brief Retrieve a string value or return a default if NULL.
      *
@@ -101,6 +496,95 @@ namespace vix::db
     {
       return isNull(i) ? def : getDouble(i);
     }
+
+    /**
+     * @brief Retrieve the column value as a C++ type.
+     *
+     * Supports integral types, bool, floating-point types, std::string,
+     * Timestamp, Date, Decimal, Uuid, DbValue, and std::optional of
+     * those (std::nullopt for SQL NULL).
+     * std::string_view and std::span<const std::byte> read through
+     * getStringView() and getBlob(), with their lifetime.
+     *
+     * @tparam T Target type.
+     * @param i Column index (zero-based).
+     * @return Column value converted to T.
+     */
+    template <typename T>
+    T get(std::size_t i) const
+    {
+      if constexpr (detail::is_optional<T>::value)
+      {
+        if (isNull(i))
+          return std::nullopt;
+        return T{get<typename T::value_type>(i)};
+      }
+      else if constexpr (std::is_same_v<T, bool>)
+        return getInt64(i) != 0;
+      else if constexpr (std::is_integral_v<T>)
+        return static_cast<T>(getInt64(i));
+      else if constexpr (std::is_floating_point_v<T>)
+        return static_cast<T>(getDouble(i));
+      else if constexpr (std::is_same_v<T, std::string>)
+        return getString(i);
+      else if constexpr (std::is_same_v<T, std::string_view>)
+        return getStringView(i);
+      else if constexpr (std::is_same_v<T, std::span<const std::byte>>)
+        return getBlob(i);
+      else if constexpr (std::is_same_v<T, DbValue>)
+        return getValue(i);
+      else if constexpr (std::is_same_v<T, Timestamp>)
+        return getTimestamp(i);
+      else if constexpr (std::is_same_v<T, Date>)
+        return getDate(i);
+      else if constexpr (std::is_same_v<T, Decimal>)
+        return getDecimal(i);
+      else if constexpr (std::is_same_v<T, Uuid>)
+        return getUuid(i);
+      else
+        static_assert(detail::dependent_false<T>, "ResultRow::get: unsupported type");
+    }
+
+    /**
+     * @brief Retrieve a column value by name as a C++ type.
+     *
+     * @tparam T Target type, see get(std::size_t).
+     * @param name Column name or alias.
+     * @return Column value converted to T.
+     * @throws DBError if there is no such column.
+     */
+    template <typename T>
+    T get(std::string_view name) const
+    {
+      return get<T>(columns().index(name));
+    }
+
+  private:
+    /// decode() for as(), leaving out columns read by column() itself:
+    /// requesting a kind would convert the stored value in place.
+    template <typename... Ts>
+    void decodeAs(std::span<Cell, sizeof...(Ts)> cells) const
+    {
+      if constexpr (!(detail::is_typed_value<Ts>() || ...))
+        decode(cells);
+      else
+      {
+        [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+          ((detail::is_typed_value<Ts>() ? void() : decode(cells.subspan(I, 1), I)), ...);
+        }(std::index_sequence_for<Ts...>{});
+      }
+    }
+
+    /// Value of column i for as(), from its decoded cell
+    template <typename T>
+    T column(const Cell &c, std::size_t i) const
+    {
+      if constexpr (detail::is_typed_value<T>())
+        return get<T>(i);
+      else
+        return detail::cell_to<T>(c);
+    }
   };
 
   /**
@@ -116,6 +600,70 @@ namespace vix::db
   {
     virtual ~ResultSet() = default;
 
+    /**
+     * @brief Single-pass iterator over the rows of a result set.
+     *
+     * Incrementing calls next(); the referenced row is valid until the
+     * following increment. Compares equal to std::default_sentinel once
+     * the rows are exhausted.
+     */
+    class Iterator
+    {
+      ResultSet *rs_ = nullptr; // null once exhausted
+
+      void advance()
+      {
+        if (rs_ && !rs_->next())
+          rs_ = nullptr;
+      }
+
+    public:
+      using iterator_concept = std::input_iterator_tag;
+      using value_type = ResultRow;
+      using difference_type = std::ptrdiff_t;
+      using reference = const ResultRow &;
+
+      Iterator() = default;
+      explicit Iterator(ResultSet *rs) : rs_(rs) { advance(); }
+
+      reference operator*() const { return rs_->row(); }
+      const ResultRow *operator->() const { return &rs_->row(); }
+
+      Iterator &operator++()
+      {
+        advance();
+        return *this;
+      }
+
+      void operator++(int) { advance(); }
+
+      friend bool operator==(const Iterator &it, std::default_sentinel_t) noexcept
+      {
+        return it.rs_ == nullptr;
+      }
+    };
+
+    /**
+     * @brief Iterate over the remaining rows.
+     *
+     * Makes the result set an input range, usable with range-for and
+     * std::views:
+     *
+     * @code
+     * for (const ResultRow &row : *rs)
+     *   std::cout << row.getInt64(0) << "\n";
+     * @endcode
+     *
+     * Starting the iteration fetches the first row; a result set can be
+     * iterated only once.
+     *
+     * @return Iterator on the first remaining row.
+     */
+    Iterator begin() { return Iterator(this); }
+
+    /// End of the rows
+    std::default_sentinel_t end() noexcept { return {}; }
+
     /**
      * @brief Advance to the next row in the result set.
      *
@@ -130,6 +678,15 @@ namespace vix::db
      */
     virtual std::size_t cols() const = 0;
 
+    /**
+     * @brief Column names, declared types and nullability.
+     *
+     * Loaded once per result set, on first use.
+     *
+     * @return Column table.
+     */
+    virtual const ColumnTable &columns() const = 0;
+
     /**
      * @brief Access the current row.
      *
@@ -138,8 +695,99 @@ namespace vix::db
      * @return Reference to the current ResultRow.
      */
     virtual const ResultRow &row() const = 0;
+
+    /**
+     * @brief Decode the current row, see ResultRow::as().
+     *
+     * @tparam T std::tuple, std::pair or a type declared with VIX_DB_FIELDS.
+     * @return The decoded row.
+     */
+    template <typename T>
+    T as() const
+    {
+      return row().template as<T>();
+    }
+
+    /**
+     * @brief Fetch up to max_rows rows into column buffers.
+     *
+     * Clears the batch, then advances the result set and appends each
+     * row to it, decoding the row in one ResultRow::decode() call.
+     * Declared in ColumnBatch.hpp.
+     *
+     * @param batch    Column buffers, reused across calls.
+     * @param max_rows Maximum number of rows to fetch.
+     * @return Number of rows fetched, 0 once the result is exhausted.
+     */
+    std::size_t fetchColumns(ColumnBatch &batch, std::size_t max_rows);
+
+    /**
+     * @brief Read the remaining rows into an in-memory buffer.
+     *
+     * Declared in RowBuffer.hpp, see RowBuffer.
+     *
+     * @return Buffer holding every remaining row.
+     */
+    RowBuffer materialize();
+
+    /**
+     * @brief Read the remaining rows into a buffer, spilling to disk
+     * above a memory limit.
+     *
+     * @param options Memory limit and spill directory.
+     * @return Buffer holding every remaining row.
+     */
+    RowBuffer materialize(const MaterializeOptions &options);
   };
 
 } // namespace vix::db
 
+// Member pointer list of VIX_DB_FIELDS, one macro per field count.
+#define VIX_DB_FIELD_PTRS_1(T, a) &T::a
+#define VIX_DB_FIELD_PTRS_2(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_1(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_3(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_2(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_4(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_3(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_5(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_4(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_6(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_5(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_7(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_6(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_8(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_7(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_9(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_8(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_10(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_9(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_11(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_10(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_12(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_11(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_13(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_12(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_14(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_13(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_15(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_14(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_16(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_15(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_17(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_16(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_18(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_17(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_19(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_18(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_20(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_19(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_21(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_20(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_22(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_21(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_23(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_22(T, __VA_ARGS__)
+#define VIX_DB_FIELD_PTRS_24(T, a, ...) &T::a, VIX_DB_FIELD_PTRS_23(T, __VA_ARGS__)
+#define VIX_DB_FIELD_COUNT_(_T, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, N, ...) N
+#define VIX_DB_FIELD_CAT_(a, b) a##b
+#define VIX_DB_FIELD_PTRS_N_(n) VIX_DB_FIELD_CAT_(VIX_DB_FIELD_PTRS_, n)
+
+/**
+ * @brief Declare the fields ResultRow::as() fills, in column order.
+ *
+ * Use at namespace scope, in the namespace of the type:
+ *
+ * @code
+ * struct User { std::int64_t id; std::string name; std::optional<double> score; };
+ * VIX_DB_FIELDS(User, id, name, score)
+ * @endcode
+ *
+ * The type must be default-constructible. Up to 24 fields.
+ */
+#define VIX_DB_FIELDS(Type, ...)                                                      \
+  [[maybe_unused]] constexpr auto vix_db_fields(const Type *) noexcept                \
+  {                                                                                   \
+    return std::make_tuple(                                                           \
+        VIX_DB_FIELD_PTRS_N_(VIX_DB_FIELD_COUNT_(Type, __VA_ARGS__, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1))(Type, __VA_ARGS__)); \
+  }
+
 #endif // VIX_DB_RESULT_HPP
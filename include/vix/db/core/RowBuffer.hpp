@@ -0,0 +1,130 @@
+/**
+ *
+ *  @file RowBuffer.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_ROW_BUFFER_HPP
+#define VIX_DB_ROW_BUFFER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <vix/db/core/Result.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief Options of ResultSet::materialize().
+   */
+  struct MaterializeOptions
+  {
+    /// Bytes of row data held in memory before the rest spills to a
+    /// temporary file; 0 keeps everything in memory
+    std::size_t memory_limit = 0;
+
+    /// Directory of the spill file, empty for the system temporary directory
+    std::string spill_dir;
+  };
+
+  /**
+   * @brief Immutable copy of the rows of a result set.
+   *
+   * Rows are encoded back to back in large chunks: a table of cell
+   * offsets per row, then one type tag and the raw value per cell.
+   * Holding a result therefore costs one allocation per chunk rather
+   * than one per string. Once MaterializeOptions::memory_limit is
+   * reached, new chunks are mapped from an unlinked temporary file
+   * instead of the heap; the per-row index stays in memory.
+   *
+   * A RowBuffer is itself a ResultSet positioned before its first row.
+   * Copies share the rows and have their own cursor, so a buffer can
+   * be cached, handed to other threads and replayed by each reader.
+   * Views returned by its rows stay valid as long as a copy exists,
+   * except the text of numeric values, valid until the next row.
+   *
+   * @code
+   * RowBuffer users = conn.prepare("SELECT id, name FROM users")->query()->materialize();
+   * for (const auto &row : users)
+   *   ...
+   * users.rewind(); // replay
+   * @endcode
+   */
+  class RowBuffer final : public ResultSet
+  {
+    struct Storage;
+
+  public:
+    /**
+     * @brief Row of a RowBuffer, decoded from its encoding on access.
+     */
+    class Row final : public ResultRow
+    {
+      const std::byte *data_ = nullptr;
+      const ColumnTable *columns_ = nullptr;
+      mutable std::vector<std::string> scratch_; // text of numeric values
+
+    public:
+      void reset(const std::byte *data, const ColumnTable &columns);
+
+      bool isNull(std::size_t i) const override;
+      std::string getString(std::size_t i) const override;
+      std::string_view getStringView(std::size_t i) const override;
+      std::span<const std::byte> getBlob(std::size_t i) const override;
+      std::int64_t getInt64(std::size_t i) const override;
+      double getDouble(std::size_t i) const override;
+      DbValue getValue(std::size_t i) const override;
+      Cell getCell(std::size_t i) const override;
+      const ColumnTable &columns() const override { return *columns_; }
+    };
+
+    /**
+     * @brief Read the remaining rows of a result set.
+     *
+     * @param source  Result set, exhausted on return.
+     * @param options Memory limit and spill directory.
+     * @throws DBError if the spill file cannot be created or grown.
+     */
+    explicit RowBuffer(ResultSet &source, const MaterializeOptions &options = {});
+
+    /// Number of rows
+    std::size_t size() const noexcept;
+
+    /// Bytes of encoded row data, in memory and spilled
+    std::size_t bytes() const noexcept;
+
+    /// Whether part of the rows lives in the spill file
+    bool spilled() const noexcept;
+
+    /**
+     * @brief Move the cursor back before the first row.
+     */
+    void rewind() noexcept { next_ = 0; }
+
+    bool next() override;
+
+    std::size_t cols() const override { return columns().size(); }
+
+    const ColumnTable &columns() const override;
+
+    const ResultRow &row() const override { return row_; }
+
+  private:
+    std::shared_ptr<const Storage> data_;
+    std::size_t next_ = 0;
+    Row row_;
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_ROW_BUFFER_HPP
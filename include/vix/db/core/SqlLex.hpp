@@ -0,0 +1,127 @@
+/**
+ *
+ *  @file SqlLex.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_SQL_LEX_HPP
+#define VIX_DB_SQL_LEX_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace vix::db
+{
+  namespace detail
+  {
+    /// ASCII letter, digit or underscore: part of a keyword or identifier
+    constexpr bool is_word_char(char c) noexcept
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+             (c >= '0' && c <= '9') || c == '_';
+    }
+
+    /// Case-insensitive comparison against an upper-case keyword
+    constexpr bool iequals(std::string_view a, std::string_view upper) noexcept
+    {
+      if (a.size() != upper.size())
+        return false;
+      for (std::size_t i = 0; i < a.size(); ++i)
+      {
+        const char c = (a[i] >= 'a' && a[i] <= 'z') ? static_cast<char>(a[i] - 'a' + 'A') : a[i];
+        if (c != upper[i])
+          return false;
+      }
+      return true;
+    }
+
+    /**
+     * @brief Skip a quoted literal, quoted identifier or comment.
+     *
+     * Recognizes '...', "..." and `...` (backslash escapes outside
+     * backticks; a doubled quote reads as two literals), and --, #
+     * and C-style comments. Unterminated ones run to the end of sql.
+     *
+     * @param sql SQL text.
+     * @param i Position to look at.
+     * @return Index just past the skipped text, or i if none starts there.
+     */
+    constexpr std::size_t skip_ignored(std::string_view sql, std::size_t i) noexcept
+    {
+      const std::size_t n = sql.size();
+      if (i >= n)
+        return i;
+
+      const char c = sql[i];
+      if (c == '\'' || c == '"' || c == '`')
+      {
+        for (++i; i < n && sql[i] != c; ++i)
+        {
+          if (sql[i] == '\\' && c != '`')
+            ++i;
+        }
+        return i < n ? i + 1 : n;
+      }
+      if (c == '#' || (c == '-' && i + 1 < n && sql[i + 1] == '-'))
+      {
+        while (i < n && sql[i] != '\n')
+          ++i;
+        return i;
+      }
+      if (c == '/' && i + 1 < n && sql[i + 1] == '*')
+      {
+        for (i += 2; i + 1 < n; ++i)
+        {
+          if (sql[i] == '*' && sql[i + 1] == '/')
+            return i + 2;
+        }
+        return n;
+      }
+      return i;
+    }
+
+    /// End of the word starting at i
+    constexpr std::size_t word_end(std::string_view sql, std::size_t i) noexcept
+    {
+      while (i < sql.size() && is_word_char(sql[i]))
+        ++i;
+      return i;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Count the positional placeholders of a SQL text.
+   *
+   * Question marks inside quoted strings, quoted identifiers and
+   * comments are not placeholders.
+   *
+   * @param sql SQL text.
+   * @return Number of '?' placeholders.
+   */
+  constexpr std::size_t count_placeholders(std::string_view sql) noexcept
+  {
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < sql.size();)
+    {
+      if (const auto next = detail::skip_ignored(sql, i); next != i)
+      {
+        i = next;
+        continue;
+      }
+      n += sql[i] == '?';
+      ++i;
+    }
+    return n;
+  }
+
+} // namespace vix::db
+
+#endif // VIX_DB_SQL_LEX_HPP
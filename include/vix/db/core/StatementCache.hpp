@@ -0,0 +1,178 @@
+/**
+ *
+ *  @file StatementCache.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_STATEMENT_CACHE_HPP
+#define VIX_DB_STATEMENT_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace vix::db
+{
+  /// Default number of prepared statements kept per connection
+  inline constexpr std::size_t kDefaultStatementCache = 64;
+
+  /**
+   * @brief Counters of a prepared statement cache.
+   */
+  struct StatementCacheStats
+  {
+    /// prepare() calls served from the cache
+    std::uint64_t hits = 0;
+
+    /// prepare() calls that had to prepare a new statement
+    std::uint64_t misses = 0;
+
+    /// Statements currently cached (leased ones are not counted)
+    std::size_t size = 0;
+
+    /// Maximum number of cached statements
+    std::size_t capacity = 0;
+  };
+
+  /**
+   * @brief LRU cache of prepared statement handles keyed by SQL text.
+   *
+   * Used by drivers inside a connection: prepare() takes the handle out
+   * of the cache, so a statement is never shared by two leases, and
+   * the lease puts it back when it is done. When several leases of the
+   * same SQL are returned, the first one is kept and the others are
+   * destroyed.
+   *
+   * Like the connection that owns it, the cache is used by one thread
+   * at a time; only stats() may be called concurrently.
+   *
+   * @tparam Handle Movable owning handle, destroying it releases the
+   *                driver statement.
+   */
+  template <typename Handle>
+  class StatementCache
+  {
+  public:
+    /// Cached statement together with its SQL text
+    struct Entry
+    {
+      std::string sql;
+      Handle handle;
+    };
+
+    /**
+     * @brief Create a cache.
+     *
+     * @param capacity Maximum number of cached statements, 0 disables it.
+     */
+    explicit StatementCache(std::size_t capacity) : capacity_(capacity) {}
+
+    StatementCache(const StatementCache &) = delete;
+    StatementCache &operator=(const StatementCache &) = delete;
+
+    /// Whether statements are cached at all
+    bool enabled() const noexcept { return capacity_ > 0; }
+
+    /**
+     * @brief Take the cached statement for a SQL text, if any.
+     *
+     * Counts a hit or a miss.
+     *
+     * @param sql SQL text.
+     * @return The cached entry, or std::nullopt on a miss.
+     */
+    std::optional<Entry> take(std::string_view sql)
+    {
+      const auto it = index_.find(sql);
+      if (it == index_.end())
+      {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+      }
+
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      const auto node = it->second;
+      index_.erase(it);
+
+      std::optional<Entry> out{std::move(*node)};
+      lru_.erase(node);
+      size_.store(lru_.size(), std::memory_order_relaxed);
+      return out;
+    }
+
+    /**
+     * @brief Return a statement to the cache.
+     *
+     * The statement must already be reset. It becomes the most recently
+     * used entry; the least recently used one is evicted when the cache
+     * is full.
+     *
+     * @param e Statement and its SQL text.
+     */
+    void put(Entry e)
+    {
+      if (capacity_ == 0 || index_.find(e.sql) != index_.end())
+        return;
+
+      lru_.push_front(std::move(e));
+      index_.emplace(lru_.front().sql, lru_.begin());
+
+      if (lru_.size() > capacity_)
+      {
+        index_.erase(lru_.back().sql);
+        lru_.pop_back();
+      }
+      size_.store(lru_.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy every cached statement.
+     */
+    void clear() noexcept
+    {
+      index_.clear();
+      lru_.clear();
+      size_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Snapshot the cache counters.
+     *
+     * @return Cache statistics.
+     */
+    StatementCacheStats stats() const noexcept
+    {
+      StatementCacheStats s;
+      s.hits = hits_.load(std::memory_order_relaxed);
+      s.misses = misses_.load(std::memory_order_relaxed);
+      s.size = size_.load(std::memory_order_relaxed);
+      s.capacity = capacity_;
+      return s;
+    }
+
+  private:
+    std::size_t capacity_;
+    std::list<Entry> lru_;
+    std::unordered_map<std::string_view, typename std::list<Entry>::iterator> index_;
+    std::atomic<std::uint64_t> hits_{0};
+    std::atomic<std::uint64_t> misses_{0};
+    std::atomic<std::size_t> size_{0};
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_STATEMENT_CACHE_HPP
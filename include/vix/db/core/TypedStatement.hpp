@@ -0,0 +1,213 @@
+/**
+ *
+ *  @file TypedStatement.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_TYPED_STATEMENT_HPP
+#define VIX_DB_TYPED_STATEMENT_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vix/db/core/Drivers.hpp>
+#include <vix/db/core/SqlLex.hpp>
+
+namespace vix::db
+{
+  /**
+   * @brief String literal usable as a template argument.
+   *
+   * @tparam N Size of the literal, terminating NUL included.
+   */
+  template <std::size_t N>
+  struct FixedString
+  {
+    char data[N]{};
+
+    constexpr FixedString(const char (&s)[N]) { std::copy_n(s, N, data); }
+
+    /// Text of the literal, without the terminating NUL
+    constexpr std::string_view view() const { return {data, N - 1}; }
+  };
+
+  namespace detail
+  {
+    /// Bind one argument through the driver's typed entry points
+    template <typename T>
+    void bind_typed(Statement &st, std::size_t idx, const T &v)
+    {
+      if constexpr (is_optional<T>::value)
+      {
+        if (v)
+          bind_typed(st, idx, *v);
+        else
+          st.bindNull(idx);
+      }
+      else if constexpr (std::is_same_v<T, std::nullptr_t> || std::is_same_v<T, std::nullopt_t>)
+        st.bindNull(idx);
+      else if constexpr (std::is_same_v<T, bool>)
+        st.bindInt64(idx, v ? 1 : 0);
+      else if constexpr (std::is_integral_v<T>)
+        st.bindInt64(idx, static_cast<std::int64_t>(v));
+      else if constexpr (std::is_floating_point_v<T>)
+        st.bindDouble(idx, static_cast<double>(v));
+      else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        st.bindText(idx, std::string_view(v));
+      else if constexpr (std::is_convertible_v<const T &, std::span<const std::byte>>)
+        st.bindBlob(idx, std::span<const std::byte>(v));
+      else if constexpr (std::is_same_v<T, Blob>)
+        st.bindBlob(idx, std::as_bytes(std::span(v.bytes)));
+      else if constexpr (std::is_same_v<T, Timestamp> || std::is_same_v<T, Date> ||
+                         std::is_same_v<T, Decimal> || std::is_same_v<T, Uuid>)
+        st.bind(idx, v);
+      else if constexpr (std::is_same_v<T, std::chrono::sys_days>)
+        st.bindDate(idx, Date::from(v));
+      else if constexpr (std::is_convertible_v<const T &, std::chrono::sys_time<std::chrono::microseconds>>)
+        st.bindTimestamp(idx, Timestamp::from(v));
+      else if constexpr (std::is_same_v<T, DbValue> || std::is_same_v<T, DbValueView> ||
+                         std::is_same_v<T, pmr::DbValue>)
+        st.bind(idx, v);
+      else
+        static_assert(dependent_false<T>, "TypedStatement: unsupported parameter type");
+    }
+  } // namespace detail
+
+  /**
+   * @brief Prepared statement whose SQL and parameter types are fixed
+   * at compile time.
+   *
+   * The number of '?' placeholders in the SQL must match the number of
+   * parameter types, or the program does not compile. Arguments are
+   * bound through the driver's typed entry points (bindInt64(),
+   * bindDouble(), bindText(), ...) without building a DbValue, and
+   * text is bound without a copy, since every call runs the statement
+   * to completion before returning.
+   *
+   * @code
+   * TypedStatement<"SELECT id, name FROM users WHERE age > ? AND country = ?",
+   *                int, std::string_view> adults(conn);
+   *
+   * for (auto [id, name] : adults.fetch<std::int64_t, std::string>(18, "FR"))
+   *   ...
+   * @endcode
+   *
+   * @tparam Sql  SQL text.
+   * @tparam Args Parameter types, in placeholder order.
+   */
+  template <FixedString Sql, typename... Args>
+  class TypedStatement
+  {
+    static_assert(count_placeholders(Sql.view()) == sizeof...(Args),
+                  "TypedStatement: placeholder count does not match the parameter types");
+
+    std::unique_ptr<Statement> st_;
+
+    void bindAll(const Args &...args)
+    {
+      std::size_t i = 1;
+      (detail::bind_typed(*st_, i++, args), ...);
+    }
+
+  public:
+    /// SQL text of the statement
+    static constexpr std::string_view sql = Sql.view();
+
+    /**
+     * @brief Prepare the statement on a connection.
+     *
+     * @param conn Connection, must outlive the statement.
+     */
+    explicit TypedStatement(Connection &conn) : st_(conn.prepare(sql)) {}
+
+    /**
+     * @brief Bind the arguments and execute the statement.
+     *
+     * @param args One argument per placeholder.
+     * @return Number of affected rows.
+     */
+    std::uint64_t exec(const Args &...args)
+    {
+      bindAll(args...);
+      return st_->exec();
+    }
+
+    /**
+     * @brief Run the query and call a function with every row.
+     *
+     * @tparam Cols Column types, see ResultRow::as().
+     * @param fn   Called with a std::tuple<Cols...> per row.
+     * @param args One argument per placeholder.
+     */
+    template <typename... Cols, typename Fn>
+    void each(Fn &&fn, const Args &...args)
+    {
+      bindAll(args...);
+      auto rs = st_->query();
+      while (rs->next())
+        fn(rs->row().template as<std::tuple<Cols...>>());
+    }
+
+    /**
+     * @brief Run the query and collect every row.
+     *
+     * @tparam Cols Column types, see ResultRow::as().
+     * @param args One argument per placeholder.
+     * @return One tuple per row.
+     */
+    template <typename... Cols>
+    std::vector<std::tuple<Cols...>> fetch(const Args &...args)
+    {
+      std::vector<std::tuple<Cols...>> out;
+      each<Cols...>([&](std::tuple<Cols...> &&row)
+                    { out.push_back(std::move(row)); },
+                    args...);
+      return out;
+    }
+
+    /**
+     * @brief Run the query and read its first row.
+     *
+     * @tparam Cols Column types, see ResultRow::as().
+     * @param args One argument per placeholder.
+     * @return The first row, or std::nullopt when there is none.
+     */
+    template <typename... Cols>
+    std::optional<std::tuple<Cols...>> fetchOne(const Args &...args)
+    {
+      bindAll(args...);
+      auto rs = st_->query();
+      if (!rs->next())
+        return std::nullopt;
+      return rs->row().template as<std::tuple<Cols...>>();
+    }
+
+    /**
+     * @brief Access the underlying prepared statement.
+     *
+     * @return Driver statement.
+     */
+    Statement &statement() noexcept { return *st_; }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_TYPED_STATEMENT_HPP
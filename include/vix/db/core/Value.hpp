@@ -15,13 +15,33 @@
 #ifndef VIX_DB_VALUE_HPP
 #define VIX_DB_VALUE_HPP
 
+#include <array>
+#include <chrono>
+#include <compare>
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER)
+#include <__msvc_int128.hpp>
+#endif
+
 namespace vix::db
 {
+#if defined(__SIZEOF_INT128__)
+  __extension__ typedef __int128 int128;
+#elif defined(_MSC_VER)
+  using int128 = std::_Signed128;
+#else
+#error "vix::db needs a 128-bit integer type"
+#endif
+
   /**
    * @brief Binary large object (BLOB) value.
    *
@@ -34,6 +54,159 @@ namespace vix::db
     std::vector<std::uint8_t> bytes;
   };
 
+  /**
+   * @brief Point in time, in microseconds since the Unix epoch (UTC).
+   *
+   * Bound as DATETIME/TIMESTAMP on MySQL and as an INTEGER on SQLite.
+   */
+  struct Timestamp
+  {
+    std::int64_t micros = 0;
+
+    /// Timestamp of a system clock time point
+    static Timestamp from(std::chrono::sys_time<std::chrono::microseconds> t) noexcept
+    {
+      return {t.time_since_epoch().count()};
+    }
+
+    /// System clock time point of the timestamp
+    std::chrono::sys_time<std::chrono::microseconds> time() const noexcept
+    {
+      return std::chrono::sys_time<std::chrono::microseconds>(std::chrono::microseconds(micros));
+    }
+
+    friend auto operator<=>(const Timestamp &, const Timestamp &) = default;
+  };
+
+  /**
+   * @brief Calendar date, in days since 1970-01-01.
+   *
+   * Bound as DATE on MySQL and as an INTEGER on SQLite.
+   */
+  struct Date
+  {
+    std::int32_t days = 0;
+
+    /// Date of a calendar day
+    static Date from(std::chrono::sys_days d) noexcept
+    {
+      return {static_cast<std::int32_t>(d.time_since_epoch().count())};
+    }
+
+    /// Calendar day of the date
+    std::chrono::sys_days day() const noexcept
+    {
+      return std::chrono::sys_days(std::chrono::days(days));
+    }
+
+    friend auto operator<=>(const Date &, const Date &) = default;
+  };
+
+  /**
+   * @brief Exact decimal number, unscaled / 10^scale.
+   *
+   * Holds up to 38 significant digits. Bound as text on MySQL, whose
+   * protocol transfers DECIMAL as text, and as a kDecimalBytes blob on
+   * SQLite, which has no exact decimal type. Comparison is on the
+   * representation: 1.0 and 1.00 differ.
+   */
+  struct Decimal
+  {
+    int128 unscaled = 0;
+    std::uint8_t scale = 0;
+
+    friend bool operator==(const Decimal &, const Decimal &) = default;
+  };
+
+  /// Size of the binary form of a Decimal: the scale, then the unscaled
+  /// value as 16 bytes of big-endian two's complement
+  inline constexpr std::size_t kDecimalBytes = 17;
+
+  /**
+   * @brief 128-bit UUID, bytes in network order.
+   *
+   * Bound as a 16-byte blob: BINARY(16) on MySQL, BLOB on SQLite.
+   */
+  struct Uuid
+  {
+    std::array<std::uint8_t, 16> bytes{};
+
+    friend auto operator<=>(const Uuid &, const Uuid &) = default;
+  };
+
+  /**
+   * @brief Format a timestamp as "YYYY-MM-DD HH:MM:SS[.ffffff]" (UTC).
+   *
+   * The fraction is written only when non-zero.
+   */
+  std::string to_string(Timestamp v);
+
+  /// Format a date as "YYYY-MM-DD"
+  std::string to_string(Date v);
+
+  /// Format a decimal as "[-]digits[.digits]", with exactly scale decimals
+  std::string to_string(const Decimal &v);
+
+  /// Format a UUID as 36 lowercase characters, "8-4-4-4-12"
+  std::string to_string(const Uuid &v);
+
+  /**
+   * @brief Parse "YYYY-MM-DD[( |T)HH:MM:SS[.fraction]][Z|(+|-)HH:MM]".
+   *
+   * A time without offset is taken as UTC; digits beyond microseconds
+   * are truncated. The year may be negative or longer than four digits,
+   * as to_string() writes it.
+   *
+   * @param s Text to parse.
+   * @return Parsed timestamp.
+   * @throws DBError if s is not a timestamp.
+   */
+  Timestamp parse_timestamp(std::string_view s);
+
+  /**
+   * @brief Parse "YYYY-MM-DD", ignoring a time part.
+   *
+   * Accepts the same years as parse_timestamp().
+   *
+   * @param s Text to parse.
+   * @return Parsed date.
+   * @throws DBError if s is not a date.
+   */
+  Date parse_date(std::string_view s);
+
+  /**
+   * @brief Parse "[+|-]digits[.digits]".
+   *
+   * @param s Text to parse.
+   * @return Parsed decimal, its scale the number of decimals.
+   * @throws DBError if s is not a decimal or has more than 38 digits.
+   */
+  Decimal parse_decimal(std::string_view s);
+
+  /**
+   * @brief Parse a UUID written as 36 characters "8-4-4-4-12" or 32 hex digits.
+   *
+   * @param s Text to parse.
+   * @return Parsed UUID.
+   * @throws DBError if s is not a UUID.
+   */
+  Uuid parse_uuid(std::string_view s);
+
+  /// Nearest double of a decimal
+  double to_double(const Decimal &v) noexcept;
+
+  /// Binary form of a decimal, see kDecimalBytes
+  std::array<std::byte, kDecimalBytes> to_bytes(const Decimal &v) noexcept;
+
+  /**
+   * @brief Read the binary form of a decimal.
+   *
+   * @param b kDecimalBytes bytes written by to_bytes().
+   * @return Decoded decimal.
+   * @throws DBError if b has the wrong size.
+   */
+  Decimal decimal_from_bytes(std::span<const std::byte> b);
+
   /**
    * @brief Type-erased database value.
    *
@@ -47,6 +220,10 @@ namespace vix::db
    * - double         : Floating-point values
    * - std::string    : Text values (UTF-8)
    * - Blob           : Binary values
+   * - Timestamp      : Date and time, UTC
+   * - Date           : Calendar date
+   * - Decimal        : Exact decimal number
+   * - Uuid           : 128-bit UUID
    *
    * This abstraction allows drivers to remain minimal while providing
    * a consistent interface across different database backends.
@@ -57,7 +234,11 @@ namespace vix::db
       std::int64_t,
       double,
       std::string,
-      Blob>;
+      Blob,
+      Timestamp,
+      Date,
+      Decimal,
+      Uuid>;
 
   /**
    * @brief Create a SQL NULL value.
@@ -111,6 +292,130 @@ namespace vix::db
     return DbValue{Blob{std::move(bytes)}};
   }
 
+  /**
+   * @brief Non-owning database value.
+   *
+   * Same alternatives as DbValue, with text and binary data referenced
+   * instead of owned. Binding a view (Statement::bind) hands the bytes
+   * to the driver without copying them, so it costs no allocation when
+   * the caller already holds the data; the data must stay alive until
+   * the statement has run.
+   */
+  using DbValueView = std::variant<
+      std::nullptr_t,
+      bool,
+      std::int64_t,
+      double,
+      std::string_view,
+      std::span<const std::byte>,
+      Timestamp,
+      Date,
+      Decimal,
+      Uuid>;
+
+  /**
+   * @brief View the content of a value.
+   *
+   * @param v Value, must outlive the view.
+   * @return Non-owning view of v.
+   */
+  inline DbValueView view(const DbValue &v) noexcept
+  {
+    return std::visit([](const auto &x) -> DbValueView
+                      {
+                        using T = std::decay_t<decltype(x)>;
+                        if constexpr (std::is_same_v<T, std::string>)
+                          return std::string_view(x);
+                        else if constexpr (std::is_same_v<T, Blob>)
+                          return std::as_bytes(std::span(x.bytes));
+                        else
+                          return x; },
+                      v);
+  }
+
+  /**
+   * @brief DbValue whose text and bytes come from a memory resource.
+   *
+   * Lets per-request parameter and row storage live in an arena, such
+   * as a std::pmr::monotonic_buffer_resource released all at once at
+   * the end of the request:
+   *
+   * @code
+   * std::pmr::monotonic_buffer_resource arena;
+   * std::pmr::vector<pmr::DbValue> params(&arena);
+   * params.push_back(pmr::value(std::string_view(name), &arena));
+   * st->bind(1, params[0]);
+   * @endcode
+   *
+   * Copying a value uses the default resource, as std::pmr::string
+   * does; pmr::value(view(v), mr) copies into a given resource.
+   */
+  namespace pmr
+  {
+    /// Binary value backed by a memory resource
+    struct Blob
+    {
+      std::pmr::vector<std::uint8_t> bytes;
+    };
+
+    using DbValue = std::variant<
+        std::nullptr_t,
+        bool,
+        std::int64_t,
+        double,
+        std::pmr::string,
+        Blob,
+        Timestamp,
+        Date,
+        Decimal,
+        Uuid>;
+
+    /**
+     * @brief Copy a value into a memory resource.
+     *
+     * @param v  Value to copy.
+     * @param mr Resource providing the text or byte storage.
+     * @return Owning value.
+     */
+    inline DbValue value(const DbValueView &v,
+                         std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+    {
+      return std::visit([mr](const auto &x) -> DbValue
+                        {
+                          using T = std::decay_t<decltype(x)>;
+                          if constexpr (std::is_same_v<T, std::string_view>)
+                            return std::pmr::string(x, mr);
+                          else if constexpr (std::is_same_v<T, std::span<const std::byte>>)
+                          {
+                            const auto *p = reinterpret_cast<const std::uint8_t *>(x.data());
+                            return Blob{std::pmr::vector<std::uint8_t>(p, p + x.size(), mr)};
+                          }
+                          else
+                            return x; },
+                        v);
+    }
+
+    /**
+     * @brief View the content of a value.
+     *
+     * @param v Value, must outlive the view.
+     * @return Non-owning view of v.
+     */
+    inline DbValueView view(const DbValue &v) noexcept
+    {
+      return std::visit([](const auto &x) -> DbValueView
+                        {
+                          using T = std::decay_t<decltype(x)>;
+                          if constexpr (std::is_same_v<T, std::pmr::string>)
+                            return std::string_view(x);
+                          else if constexpr (std::is_same_v<T, Blob>)
+                            return std::as_bytes(std::span(x.bytes));
+                          else
+                            return x; },
+                        v);
+    }
+  } // namespace pmr
+
 } // namespace vix::db
 
 #endif // VIX_DB_VALUE_HPP
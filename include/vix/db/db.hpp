@@ -17,9 +17,18 @@
 #define VIX_DB_HPP
 
 #include <vix/db/core/Errors.hpp>
+#include <vix/db/core/Expected.hpp>
 #include <vix/db/core/Value.hpp>
 #include <vix/db/core/Drivers.hpp>
+#include <vix/db/core/TypedStatement.hpp>
+#include <vix/db/core/ColumnBatch.hpp>
+#include <vix/db/core/Prefetch.hpp>
+#include <vix/db/core/RowBuffer.hpp>
 #include <vix/db/pool/ConnectionPool.hpp>
+#include <vix/db/pool/PoolStats.hpp>
+#include <vix/db/pool/ReplicaPool.hpp>
+#include <vix/db/async/DbExecutor.hpp>
+#include <vix/db/async/AsyncDb.hpp>
 #include <vix/db/Transaction.hpp>
 #include <vix/db/Database.hpp>
 #include <vix/db/mig/Migration.hpp>
@@ -20,6 +20,7 @@
 #include <vix/db/core/Drivers.hpp>
 
 #include <cppconn/connection.h>
+#include <cppconn/prepared_statement.h>
 #include <mysql_driver.h>
 
 #include <memory>
@@ -27,6 +28,9 @@
 
 namespace vix::db
 {
+  /// Prepared statement cache of a MySQL connection
+  using MySQLStatementCache = StatementCache<std::unique_ptr<sql::PreparedStatement>>;
+
   /**
    * @brief MySQL implementation of a database connection.
    *
@@ -40,19 +44,30 @@ namespace vix::db
   class MySQLConnection final : public Connection
   {
     std::shared_ptr<sql::Connection> conn_;
+    MySQLStatementCache cache_;
+    std::size_t max_packet_ = 0;
 
   public:
     /**
      * @brief Construct a MySQL connection wrapper.
      *
-     * @param c Shared pointer to a native MySQL Connector/C++ connection.
+     * @param c               Shared pointer to a native MySQL Connector/C++ connection.
+     * @param statement_cache Number of server-side prepared statements
+     *                        kept for reuse, 0 disables the cache.
      */
-    explicit MySQLConnection(std::shared_ptr<sql::Connection> c)
-        : conn_(std::move(c)) {}
+    explicit MySQLConnection(std::shared_ptr<sql::Connection> c,
+                             std::size_t statement_cache = kDefaultStatementCache)
+        : conn_(std::move(c)), cache_(statement_cache) {}
 
     /**
      * @brief Prepare a SQL statement.
      *
+     * Reuses a cached server-side statement for the same SQL text when
+     * one is available. The handle goes back to the cache, with its
+     * parameters cleared, once the returned statement and every result
+     * set it produced are destroyed. Those must not outlive the
+     * connection.
+     *
      * @param sql SQL query string (UTF-8).
      * @return Owning pointer to a prepared Statement.
      */
@@ -111,6 +126,27 @@ namespace vix::db
       }
     }
 
+    /**
+     * @brief Counters of the prepared statement cache.
+     *
+     * @return Cache statistics.
+     */
+    StatementCacheStats statementCacheStats() const override { return cache_.stats(); }
+
+    /**
+     * @brief Placeholder and packet limits of the connection.
+     *
+     * max_allowed_packet is read from the server on first use.
+     *
+     * @return 65535 placeholders and the session's max_allowed_packet.
+     */
+    InsertLimits insertLimits() override;
+
+    /**
+     * @brief MySQL quotes identifiers with backticks.
+     */
+    char identifierQuote() const override { return '`'; }
+
     /**
      * @brief Access the underlying native MySQL connection.
      *
@@ -146,17 +182,19 @@ namespace vix::db
    * vix::db::Connection instances. This is typically used
    * by connection pools or dependency injection systems.
    *
-   * @param host Database host.
-   * @param user Username.
-   * @param pass Password.
-   * @param db   Database name.
+   * @param host            Database host.
+   * @param user            Username.
+   * @param pass            Password.
+   * @param db              Database name.
+   * @param statement_cache Prepared statements cached per connection.
    * @return Factory function producing Connection instances.
    */
   std::function<std::shared_ptr<Connection>()>
   make_mysql_factory(std::string host,
                      std::string user,
                      std::string pass,
-                     std::string db);
+                     std::string db,
+                     std::size_t statement_cache = kDefaultStatementCache);
 
 } // namespace vix::db
 
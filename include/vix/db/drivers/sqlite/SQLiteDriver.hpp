@@ -23,6 +23,18 @@
 
 namespace vix::db
 {
+  /// Deleter finalizing a SQLite statement
+  struct SQLiteStmtFinalizer
+  {
+    void operator()(sqlite3_stmt *stmt) const noexcept { sqlite3_finalize(stmt); }
+  };
+
+  /// Owning SQLite statement handle
+  using SQLiteStmtHandle = std::unique_ptr<sqlite3_stmt, SQLiteStmtFinalizer>;
+
+  /// Prepared statement cache of a SQLite connection
+  using SQLiteStatementCache = StatementCache<SQLiteStmtHandle>;
+
   /**
    * @brief SQLite implementation of a database connection.
    *
@@ -35,19 +47,25 @@ namespace vix::db
   class SQLiteConnection final : public Connection
   {
     sqlite3 *db_ = nullptr;
+    SQLiteStatementCache cache_;
 
   public:
     /**
      * @brief Construct a SQLite connection wrapper.
      *
-     * @param db Raw sqlite3 handle.
+     * @param db              Raw sqlite3 handle.
+     * @param statement_cache Number of prepared statements kept for
+     *                        reuse, 0 disables the cache.
      */
-    explicit SQLiteConnection(sqlite3 *db) : db_(db) {}
+    explicit SQLiteConnection(sqlite3 *db, std::size_t statement_cache = kDefaultStatementCache)
+        : db_(db), cache_(statement_cache) {}
 
     /**
      * @brief Destroy the SQLite connection.
      *
-     * Closes the underlying sqlite3 handle.
+     * Finalizes cached statements and closes the underlying sqlite3
+     * handle. Statements prepared on this connection must be destroyed
+     * first.
      */
     ~SQLiteConnection() override;
 
@@ -57,6 +75,11 @@ namespace vix::db
     /**
      * @brief Prepare a SQL statement.
      *
+     * Reuses a cached statement for the same SQL text when one is
+     * available. The returned statement leases the handle: destroying
+     * it resets the handle, clears its bindings and puts it back in
+     * the cache.
+     *
      * @param sql SQL query string (UTF-8).
      * @return Owning pointer to a prepared Statement.
      */
@@ -91,6 +114,20 @@ namespace vix::db
      */
     bool ping() override { return db_ != nullptr; }
 
+    /**
+     * @brief Counters of the prepared statement cache.
+     *
+     * @return Cache statistics.
+     */
+    StatementCacheStats statementCacheStats() const override { return cache_.stats(); }
+
+    /**
+     * @brief Placeholder limit of the connection.
+     *
+     * @return SQLITE_LIMIT_VARIABLE_NUMBER as set on the handle.
+     */
+    InsertLimits insertLimits() override;
+
     /**
      * @brief Access the underlying sqlite3 handle.
      *
@@ -118,10 +155,12 @@ namespace vix::db
    * vix::db::Connection instances. Commonly used by
    * connection pools or database abstractions.
    *
-   * @param path Path to the SQLite database file.
+   * @param path            Path to the SQLite database file.
+   * @param statement_cache Prepared statements cached per connection.
    * @return Connection factory.
    */
-  ConnectionFactory make_sqlite_factory(std::string path);
+  ConnectionFactory make_sqlite_factory(std::string path,
+                                        std::size_t statement_cache = kDefaultStatementCache);
 
 } // namespace vix::db
 
@@ -15,13 +15,22 @@
 #ifndef VIX_DB_CONNECTION_POOL_HPP
 #define VIX_DB_CONNECTION_POOL_HPP
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
+#include <deque>
+#include <functional>
 #include <mutex>
-#include <queue>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
 
 #include <vix/db/core/Drivers.hpp>
+#include <vix/db/core/Errors.hpp>
+#include <vix/db/pool/PoolStats.hpp>
 
 namespace vix::db
 {
@@ -35,6 +44,30 @@ namespace vix::db
 
     /// Maximum number of connections allowed in the pool
     std::size_t max = 8;
+
+    /// Keep per-thread fast-path slots in front of the shared idle stock
+    bool local_cache = true;
+
+    /// Maximum time acquire() waits for a connection (0 = wait forever)
+    std::chrono::milliseconds acquire_timeout{0};
+
+    /// Close idle connections above `min` after this long (0 = never)
+    std::chrono::milliseconds idle_timeout{0};
+
+    /// Retire connections older than this (0 = never)
+    std::chrono::milliseconds max_lifetime{0};
+
+    /// Up to this much is randomly taken off max_lifetime per connection,
+    /// so connections opened together do not all expire together
+    std::chrono::milliseconds lifetime_jitter{0};
+
+    /// Ping idle connections in the background at this interval instead of
+    /// on acquire() (0 = validate on acquire)
+    std::chrono::milliseconds validation_interval{0};
+
+    /// Connections idle for less than this are handed out without a ping
+    /// (0 = always ping on acquire)
+    std::chrono::milliseconds validate_after{500};
   };
 
   /**
@@ -46,53 +79,247 @@ namespace vix::db
    * usage.
    *
    * The pool enforces a maximum number of total connections and blocks
-   * callers when no connection is available.
+   * callers when no connection is available. Blocked callers are served
+   * in arrival order: release() hands the connection directly to the
+   * oldest waiter, and a waiter whose deadline expires leaves the queue
+   * with a PoolTimeout.
+   *
+   * Idle connections are kept in two tiers. Each thread owns a local
+   * slot where release() parks its connection and acquire() takes it
+   * back without touching the pool mutex. The shared idle stock behind
+   * the mutex is only used when the local slot is empty or occupied,
+   * or when other callers are waiting for a connection.
+   *
+   * When idle_timeout, max_lifetime or validation_interval is set, a
+   * maintenance thread periodically closes surplus idle connections,
+   * retires old ones, pings idle ones and refills the pool up to
+   * PoolConfig::min, so none of that work happens on the request path.
    */
   class ConnectionPool
   {
+  public:
+    /// Clock used for deadlines and connection ages
+    using Clock = std::chrono::steady_clock;
+
+  private:
+    /// Idle connection and the time it was returned to the pool
+    struct Idle
+    {
+      ConnectionPtr conn;
+      Clock::time_point since;
+    };
+
+    /// Maintenance bookkeeping kept for every live connection
+    struct Lifetime
+    {
+      Clock::time_point expires;
+      Clock::time_point checked;
+    };
+
+    /**
+     * @brief Per-thread fast-path slot.
+     *
+     * Slots are try-locked on the fast path: a thread that finds its
+     * slot busy falls back to the shared stock instead of spinning.
+     * Only the hand-over to a queued waiter waits for the slot, so a
+     * parked connection cannot be missed.
+     */
+    struct alignas(64) LocalSlot
+    {
+      std::atomic<bool> busy{false};
+
+      /// Whether entry holds a connection, readable without taking busy
+      std::atomic<bool> occupied{false};
+      Idle entry;
+
+      /// acquire() calls served from this slot, reported as zero wait
+      std::atomic<std::uint64_t> hits{0};
+    };
+
+    /**
+     * @brief Blocked acquire() call, queued in arrival order.
+     *
+     * A waiter is granted either a released connection or, when the
+     * pool shrank below its maximum, the right to create a new one.
+     */
+    struct Waiter
+    {
+      std::condition_variable cv;
+      Idle entry;
+      Waiter *prev = nullptr;
+      Waiter *next = nullptr;
+      bool granted = false;
+    };
+
     ConnectionFactory factory_;
     PoolConfig cfg_{};
 
-    std::mutex m_;
-    std::condition_variable cv_;
-    std::queue<ConnectionPtr> idle_;
+    std::unique_ptr<LocalSlot[]> slots_;
+    std::size_t slot_mask_ = 0;
+    std::atomic<std::size_t> waiters_{0};
+
+    mutable std::mutex m_;
+    std::deque<Idle> idle_;
+    Waiter *head_ = nullptr;
+    Waiter *tail_ = nullptr;
     std::size_t total_ = 0;
+    std::unordered_map<const Connection *, Lifetime> lifetimes_;
+    std::minstd_rand rng_;
+
+    LatencyHistogram acquire_wait_;
+    LatencyHistogram connect_time_;
+    std::atomic<std::uint64_t> created_{0};
+    std::atomic<std::uint64_t> destroyed_{0};
+    std::atomic<std::uint64_t> timeouts_{0};
+
+    std::condition_variable maint_cv_;
+    bool stop_ = false;
+    std::thread maintainer_;
+
+    LocalSlot *localSlot() noexcept;
+    static Idle takeLocal(LocalSlot &slot, bool wait = false) noexcept;
+    static bool putLocal(LocalSlot &slot, ConnectionPtr &c) noexcept;
+    Idle stealLocal(bool wait = false) noexcept;
+
+    void enqueue(Waiter &w) noexcept;
+    void unlink(Waiter &w) noexcept;
+    void handOff(Idle e);
+    void track(const Connection *c);
+    void forget(const Connection *c);
+    void discard(const Connection *c);
+    bool usable(const Idle &e) const;
+    ConnectionPtr create();
+    ConnectionPtr acquireUntil(Clock::time_point deadline);
+    ConnectionPtr acquireShared(Clock::time_point deadline);
+    void maintenanceLoop(Clock::duration period);
 
   public:
+
     /**
      * @brief Construct a connection pool.
      *
      * @param factory Factory function used to create new connections.
      * @param cfg     Pool configuration parameters.
      */
-    ConnectionPool(ConnectionFactory factory, PoolConfig cfg = {})
-        : factory_(std::move(factory)), cfg_(cfg) {}
+    ConnectionPool(ConnectionFactory factory, PoolConfig cfg = {});
+
+    /**
+     * @brief Stop the maintenance thread, if any.
+     *
+     * Connections still checked out are not tracked anymore and simply
+     * close when their last owner drops them.
+     */
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
 
     /**
      * @brief Acquire a connection from the pool.
      *
-     * If no idle connection is available and the maximum number of
-     * connections has not been reached, a new connection is created.
-     * Otherwise, the call blocks until a connection is released.
+     * The calling thread's local slot is tried first, then the shared
+     * idle stock and the slots of other threads. If no idle connection
+     * is available and the maximum number of connections has not been
+     * reached, a new connection is created. Otherwise, the call blocks
+     * until a connection is released, or until PoolConfig::acquire_timeout
+     * elapses when it is set.
      *
      * @return Shared pointer to an active database connection.
+     * @throws PoolTimeout if the configured acquire timeout elapses.
      */
     ConnectionPtr acquire();
 
+    /**
+     * @brief Acquire a connection, waiting at most until a deadline.
+     *
+     * @param deadline Point in time after which the call gives up.
+     * @return Shared pointer to an active database connection.
+     * @throws PoolTimeout if no connection was handed over in time.
+     */
+    ConnectionPtr acquire(Clock::time_point deadline);
+
+    /**
+     * @brief Try to acquire a connection within a time budget.
+     *
+     * Same as acquire(Clock::time_point) but reports a timeout by
+     * returning an empty pointer instead of throwing.
+     *
+     * @param timeout Maximum time to wait.
+     * @return Connection, or nullptr if the timeout elapsed.
+     */
+    ConnectionPtr tryAcquireFor(Clock::duration timeout);
+
     /**
      * @brief Release a connection back to the pool.
      *
+     * The connection is parked in the calling thread's local slot when
+     * nobody is waiting, otherwise it is handed to the oldest waiter.
+     *
      * @param c Connection to release.
      */
     void release(ConnectionPtr c);
 
+    /**
+     * @brief Drop a broken connection instead of returning it.
+     *
+     * The connection is closed and its capacity is given to the oldest
+     * waiter, if any.
+     *
+     * @param c Connection to drop.
+     */
+    void invalidate(ConnectionPtr c);
+
+    /**
+     * @brief Run a callable with a pooled connection, retrying once.
+     *
+     * If the callable throws ConnectionLost, the broken connection is
+     * dropped and the callable runs once more on another connection.
+     * Only use this for work that is safe to repeat: a statement that
+     * was in flight when the connection died may or may not have been
+     * applied by the server.
+     *
+     * @param fn Callable invoked as fn(Connection &).
+     * @return Whatever fn returns.
+     */
+    template <typename Fn>
+    std::invoke_result_t<Fn &, Connection &> withConnection(Fn &&fn);
+
     /**
      * @brief Pre-create the minimum number of connections.
      *
      * Ensures that at least PoolConfig::min connections are created
-     * and available in the idle pool.
+     * and available in the idle pool. Connections are opened in
+     * parallel and without holding the pool mutex, so callers can
+     * acquire the first ones while the rest are still connecting.
+     *
+     * @param on_first Optional callback invoked once, from whichever
+     *                 thread opened it, when the first connection is
+     *                 in the pool (immediately if nothing is missing).
+     * @throws The first error raised by the factory, after every
+     *         other connection attempt has finished.
+     */
+    void warmup(const std::function<void()> &on_first = {});
+
+    /**
+     * @brief Run one maintenance pass on the calling thread.
+     *
+     * Closes idle connections past PoolConfig::idle_timeout while more
+     * than PoolConfig::min exist, retires connections past their
+     * lifetime, pings idle connections due for validation and creates
+     * connections until PoolConfig::min is reached again. The pool's
+     * maintenance thread calls this periodically.
      */
-    void warmup();
+    void maintain();
+
+    /**
+     * @brief Take a snapshot of the pool state and counters.
+     *
+     * Counters are updated with relaxed atomics on the request path;
+     * this call briefly takes the pool mutex to count idle connections.
+     *
+     * @return Pool statistics.
+     */
+    PoolStats stats() const;
   };
 
   /**
@@ -118,6 +345,16 @@ namespace vix::db
     explicit PooledConn(ConnectionPool &p)
         : pool_(p), c_(p.acquire()) {}
 
+    /**
+     * @brief Acquire a pooled connection before a deadline.
+     *
+     * @param p        Reference to the connection pool.
+     * @param deadline Point in time after which acquisition fails.
+     * @throws PoolTimeout if no connection was available in time.
+     */
+    PooledConn(ConnectionPool &p, ConnectionPool::Clock::time_point deadline)
+        : pool_(p), c_(p.acquire(deadline)) {}
+
     /**
      * @brief Release the connection back to the pool.
      */
@@ -187,8 +424,38 @@ namespace vix::db
      * @return Const reference to the ConnectionPtr.
      */
     const ConnectionPtr &ptr() const { return c_; }
+
+    /**
+     * @brief Drop the connection instead of returning it to the pool.
+     *
+     * Use this when the connection is known to be broken.
+     */
+    void invalidate()
+    {
+      if (c_)
+        pool_.invalidate(std::move(c_));
+    }
   };
 
+  template <typename Fn>
+  std::invoke_result_t<Fn &, Connection &> ConnectionPool::withConnection(Fn &&fn)
+  {
+    {
+      PooledConn c(*this);
+      try
+      {
+        return fn(c.get());
+      }
+      catch (const ConnectionLost &)
+      {
+        c.invalidate();
+      }
+    }
+
+    PooledConn c(*this);
+    return fn(c.get());
+  }
+
 } // namespace vix::db
 
 #endif // VIX_DB_CONNECTION_POOL_HPP
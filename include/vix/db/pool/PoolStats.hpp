@@ -0,0 +1,204 @@
+/**
+ *
+ *  @file PoolStats.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_POOL_STATS_HPP
+#define VIX_DB_POOL_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace vix::db
+{
+  /// Number of buckets in a LatencyHistogram
+  inline constexpr std::size_t kHistogramBuckets = 32;
+
+  /**
+   * @brief Point-in-time copy of a LatencyHistogram.
+   *
+   * Bucket i counts samples strictly below 2^i microseconds and at or
+   * above the previous bound, the last bucket also takes everything
+   * larger (about 35 minutes and up).
+   */
+  struct HistogramSnapshot
+  {
+    /// Per-bucket sample counts (not cumulative)
+    std::array<std::uint64_t, kHistogramBuckets> buckets{};
+
+    /// Sum of all recorded samples, in nanoseconds
+    std::uint64_t sum_ns = 0;
+
+    /**
+     * @brief Upper bound of a bucket, in seconds.
+     *
+     * @param i Bucket index.
+     * @return 2^i microseconds expressed in seconds.
+     */
+    static double upperBoundSeconds(std::size_t i)
+    {
+      return std::ldexp(1e-6, static_cast<int>(i));
+    }
+
+    /**
+     * @brief Total number of samples.
+     *
+     * @return Sum of all bucket counts.
+     */
+    std::uint64_t count() const noexcept
+    {
+      std::uint64_t n = 0;
+      for (auto b : buckets)
+        n += b;
+      return n;
+    }
+
+    /**
+     * @brief Estimate a quantile from the buckets.
+     *
+     * The result is the upper bound of the bucket holding the quantile,
+     * so it overestimates by at most a factor of two.
+     *
+     * @param q Quantile in [0, 1], e.g. 0.99.
+     * @return Estimated latency, zero when no sample was recorded.
+     */
+    std::chrono::nanoseconds quantile(double q) const noexcept
+    {
+      const std::uint64_t n = count();
+      if (n == 0)
+        return std::chrono::nanoseconds{0};
+
+      const auto rank = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(n)));
+      std::uint64_t seen = 0;
+      for (std::size_t i = 0; i < buckets.size(); ++i)
+      {
+        seen += buckets[i];
+        if (seen >= rank && seen > 0)
+          return std::chrono::nanoseconds{std::int64_t{1000} << i};
+      }
+      return std::chrono::nanoseconds{std::int64_t{1000} << (kHistogramBuckets - 1)};
+    }
+  };
+
+  /**
+   * @brief Lock-free latency histogram with logarithmic buckets.
+   *
+   * Each record() is two relaxed atomic increments; buckets double in
+   * width, which keeps a fixed relative precision (within 2x) from one
+   * microsecond to tens of minutes.
+   */
+  class LatencyHistogram
+  {
+    std::array<std::atomic<std::uint64_t>, kHistogramBuckets> buckets_{};
+    std::atomic<std::uint64_t> sum_ns_{0};
+
+  public:
+    /**
+     * @brief Bucket index for a duration.
+     *
+     * @param d Sample duration.
+     * @return Bucket index in [0, kHistogramBuckets).
+     */
+    static std::size_t bucketFor(std::chrono::nanoseconds d) noexcept
+    {
+      const auto us = static_cast<std::uint64_t>(
+          std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count(), 0));
+      const auto i = static_cast<std::size_t>(std::bit_width(us));
+      return i < kHistogramBuckets ? i : kHistogramBuckets - 1;
+    }
+
+    /**
+     * @brief Record one sample.
+     *
+     * @param d Sample duration.
+     */
+    void record(std::chrono::nanoseconds d) noexcept
+    {
+      buckets_[bucketFor(d)].fetch_add(1, std::memory_order_relaxed);
+      sum_ns_.fetch_add(static_cast<std::uint64_t>(std::max<std::int64_t>(d.count(), 0)),
+                        std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copy the current counts.
+     *
+     * Buckets are read one by one, so a snapshot taken under load may
+     * be off by the samples recorded while it was being copied.
+     *
+     * @return Histogram snapshot.
+     */
+    HistogramSnapshot snapshot() const noexcept
+    {
+      HistogramSnapshot s;
+      for (std::size_t i = 0; i < kHistogramBuckets; ++i)
+        s.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+      s.sum_ns = sum_ns_.load(std::memory_order_relaxed);
+      return s;
+    }
+  };
+
+  /**
+   * @brief Snapshot of a connection pool's state and counters.
+   */
+  struct PoolStats
+  {
+    /// Connections currently checked out
+    std::size_t in_use = 0;
+
+    /// Connections idle in the pool (shared stock and local slots)
+    std::size_t idle = 0;
+
+    /// Callers blocked in acquire()
+    std::size_t waiters = 0;
+
+    /// Configured maximum number of connections
+    std::size_t max = 0;
+
+    /// Connections opened since the pool was created
+    std::uint64_t created = 0;
+
+    /// Connections closed by the pool since it was created
+    std::uint64_t destroyed = 0;
+
+    /// acquire() calls that gave up on their deadline
+    std::uint64_t timeouts = 0;
+
+    /// Time spent in acquire(), including the zero-wait fast path
+    HistogramSnapshot acquire_wait;
+
+    /// Time spent in the connection factory
+    HistogramSnapshot connect_time;
+  };
+
+  /**
+   * @brief Render pool statistics in the Prometheus text format.
+   *
+   * Every pool becomes a set of samples labelled pool="<name>" under
+   * the vix_db_pool_* metric families.
+   *
+   * @param pools Pool name and statistics pairs.
+   * @return Exposition text, ready to be served on a /metrics endpoint.
+   */
+  std::string render_prometheus(const std::vector<std::pair<std::string, PoolStats>> &pools);
+
+} // namespace vix::db
+
+#endif // VIX_DB_POOL_STATS_HPP
@@ -0,0 +1,183 @@
+/**
+ *
+ *  @file ReplicaPool.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_REPLICA_POOL_HPP
+#define VIX_DB_REPLICA_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <vix/db/pool/ConnectionPool.hpp>
+
+namespace vix::db
+{
+  class RoutedConn;
+
+  /**
+   * @brief Connection pool of one read replica, with load and health.
+   *
+   * The load is the number of connections currently leased through
+   * RoutedConn; Database::reader() picks the healthy replica with the
+   * lowest one. A replica whose connections fail is taken out of the
+   * rotation for an exponentially growing backoff, then tried again.
+   */
+  class ReplicaPool
+  {
+    friend class RoutedConn;
+
+    std::string name_;
+    ConnectionPool pool_;
+    std::atomic<std::size_t> outstanding_{0};
+    std::atomic<std::uint32_t> failures_{0};
+    std::atomic<ConnectionPool::Clock::rep> retry_at_{0};
+
+  public:
+    /**
+     * @brief Create a replica pool.
+     *
+     * @param name    Name used in statistics, e.g. "replica-0".
+     * @param factory Connection factory for the replica endpoint.
+     * @param cfg     Pool configuration.
+     */
+    ReplicaPool(std::string name, ConnectionFactory factory, const PoolConfig &cfg);
+
+    ReplicaPool(const ReplicaPool &) = delete;
+    ReplicaPool &operator=(const ReplicaPool &) = delete;
+
+    /// Replica name
+    const std::string &name() const noexcept { return name_; }
+
+    /// Underlying connection pool
+    ConnectionPool &pool() noexcept { return pool_; }
+
+    /// Underlying connection pool (const)
+    const ConnectionPool &pool() const noexcept { return pool_; }
+
+    /// Connections currently leased from this replica
+    std::size_t outstanding() const noexcept { return outstanding_.load(std::memory_order_relaxed); }
+
+    /// Consecutive failures since the replica was last healthy
+    std::uint32_t failures() const noexcept { return failures_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Whether the replica is in the read rotation.
+     *
+     * @return false while a failure backoff is running.
+     */
+    bool healthy() const noexcept;
+
+    /**
+     * @brief Record a failure and start or extend the backoff.
+     */
+    void markFailed() noexcept;
+
+    /**
+     * @brief Record a success and clear the failure state.
+     */
+    void markHealthy() noexcept;
+
+    /**
+     * @brief Lease a connection, counting it in the replica load.
+     *
+     * @return Routed connection bound to this replica.
+     * @throws PoolTimeout if the pool's acquire_timeout expires.
+     * @throws DBError if a connection cannot be opened; the replica
+     *         is marked failed.
+     */
+    RoutedConn lease();
+  };
+
+  /**
+   * @brief Pooled connection leased from a primary or a replica.
+   *
+   * Behaves like PooledConn, and additionally keeps the replica's load
+   * count while it is alive.
+   */
+  class RoutedConn
+  {
+    PooledConn conn_;
+    ReplicaPool *replica_ = nullptr;
+
+  public:
+    /**
+     * @brief Wrap a pooled connection.
+     *
+     * @param conn    Pooled connection.
+     * @param replica Replica it was leased from, or nullptr for the
+     *                primary. Its load must already count this lease.
+     */
+    RoutedConn(PooledConn conn, ReplicaPool *replica) noexcept
+        : conn_(std::move(conn)), replica_(replica) {}
+
+    /**
+     * @brief Release the replica load; the connection returns to its pool.
+     */
+    ~RoutedConn() noexcept
+    {
+      if (replica_)
+        replica_->outstanding_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    RoutedConn(const RoutedConn &) = delete;
+    RoutedConn &operator=(const RoutedConn &) = delete;
+
+    /**
+     * @brief Move-construct a routed connection.
+     *
+     * @param other Routed connection to move from.
+     */
+    RoutedConn(RoutedConn &&other) noexcept
+        : conn_(std::move(other.conn_)), replica_(other.replica_)
+    {
+      other.replica_ = nullptr;
+    }
+
+    /**
+     * @brief Access the underlying connection.
+     *
+     * @return Reference to the connection.
+     */
+    Connection &get() { return conn_.get(); }
+
+    /// Pointer-like access to the connection
+    Connection *operator->() { return &conn_.get(); }
+
+    /// Dereference access to the connection
+    Connection &operator*() { return conn_.get(); }
+
+    /**
+     * @brief Replica the connection was leased from.
+     *
+     * @return Replica, or nullptr when the connection is on the primary.
+     */
+    ReplicaPool *replica() const noexcept { return replica_; }
+
+    /**
+     * @brief Drop the connection instead of returning it to the pool.
+     *
+     * On a replica this also counts as a replica failure.
+     */
+    void invalidate()
+    {
+      if (replica_)
+        replica_->markFailed();
+      conn_.invalidate();
+    }
+  };
+
+} // namespace vix::db
+
+#endif // VIX_DB_REPLICA_POOL_HPP
@@ -11,6 +11,7 @@
  *  Vix.cpp
  */
 #include <vix/db/Database.hpp>
+#include <vix/db/core/SqlLex.hpp>
 
 #if VIX_DB_HAS_MYSQL
 #include <vix/db/drivers/mysql/MySQLDriver.hpp>
@@ -22,7 +23,11 @@
 
 #include <vix/config/Config.hpp>
 
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 namespace vix::db
@@ -43,9 +48,48 @@ namespace vix::db
     out.mysql.database = cfg.getString("db.database", "vixdb");
     out.mysql.pool.min = static_cast<std::size_t>(cfg.getInt("db.pool.min", 1));
     out.mysql.pool.max = static_cast<std::size_t>(cfg.getInt("db.pool.max", 8));
+    out.mysql.pool.acquire_timeout =
+        std::chrono::milliseconds(cfg.getInt("db.pool.acquire_timeout_ms", 0));
+    out.mysql.pool.idle_timeout =
+        std::chrono::milliseconds(cfg.getInt("db.pool.idle_timeout_ms", 0));
+    out.mysql.pool.max_lifetime =
+        std::chrono::milliseconds(cfg.getInt("db.pool.max_lifetime_ms", 0));
+    out.mysql.pool.lifetime_jitter =
+        std::chrono::milliseconds(cfg.getInt("db.pool.lifetime_jitter_ms", 0));
+    out.mysql.pool.validation_interval =
+        std::chrono::milliseconds(cfg.getInt("db.pool.validation_interval_ms", 0));
+    out.mysql.pool.validate_after =
+        std::chrono::milliseconds(cfg.getInt("db.pool.validate_after_ms", 500));
+    out.mysql.statement_cache = static_cast<std::size_t>(
+        cfg.getInt("db.statement_cache", static_cast<int>(kDefaultStatementCache)));
+
+    // Comma-separated replica hosts sharing the primary's credentials.
+    const auto replicas = cfg.getString("db.replicas", "");
+    for (std::size_t pos = 0; pos < replicas.size();)
+    {
+      auto end = replicas.find(',', pos);
+      if (end == std::string::npos)
+        end = replicas.size();
+
+      auto host = replicas.substr(pos, end - pos);
+      host.erase(0, host.find_first_not_of(" \t"));
+      host.erase(host.find_last_not_of(" \t") + 1);
+      if (!host.empty())
+      {
+        MySQLReplicaConfig r;
+        r.host = std::move(host);
+        r.pool = out.mysql.pool;
+        out.mysql.replicas.push_back(std::move(r));
+      }
+      pos = end + 1;
+    }
+
+    if (cfg.getString("db.startup", "blocking") == "async")
+      out.startup = Startup::Async;
 
     out.sqlite.path = cfg.getString("db.sqlite", "vix_db.sqlite");
     out.sqlite.pool = out.mysql.pool;
+    out.sqlite.statement_cache = out.mysql.statement_cache;
 
     return out;
   }
@@ -59,7 +103,8 @@ namespace vix::db
       case Engine::MySQL:
       {
 #if VIX_DB_HAS_MYSQL
-        return make_mysql_factory(cfg.mysql.host, cfg.mysql.user, cfg.mysql.password, cfg.mysql.database);
+        return make_mysql_factory(cfg.mysql.host, cfg.mysql.user, cfg.mysql.password, cfg.mysql.database,
+                                  cfg.mysql.statement_cache);
 #else
         throw std::runtime_error("MySQL requested but VIX_DB_HAS_MYSQL=0");
 #endif
@@ -68,7 +113,7 @@ namespace vix::db
       case Engine::SQLite:
       {
 #if VIX_DB_HAS_SQLITE
-        return make_sqlite_factory(cfg.sqlite.path);
+        return make_sqlite_factory(cfg.sqlite.path, cfg.sqlite.statement_cache);
 #else
         throw std::runtime_error("SQLite requested but VIX_DB_HAS_SQLITE=0");
 #endif
@@ -79,6 +124,50 @@ namespace vix::db
       }
     }
 
+    std::vector<std::unique_ptr<ReplicaPool>> make_replicas(const DbConfig &cfg)
+    {
+      std::vector<std::unique_ptr<ReplicaPool>> out;
+      if (cfg.engine != Engine::MySQL)
+        return out;
+
+      out.reserve(cfg.mysql.replicas.size());
+      for (std::size_t i = 0; i < cfg.mysql.replicas.size(); ++i)
+      {
+        const auto &r = cfg.mysql.replicas[i];
+#if VIX_DB_HAS_MYSQL
+        auto factory = make_mysql_factory(
+            r.host,
+            r.user.empty() ? cfg.mysql.user : r.user,
+            r.password.empty() ? cfg.mysql.password : r.password,
+            r.database.empty() ? cfg.mysql.database : r.database,
+            cfg.mysql.statement_cache);
+#else
+        ConnectionFactory factory = []() -> ConnectionPtr
+        { throw std::runtime_error("MySQL requested but VIX_DB_HAS_MYSQL=0"); };
+#endif
+        out.push_back(std::make_unique<ReplicaPool>(
+            "replica-" + std::to_string(i), std::move(factory), r.pool));
+      }
+      return out;
+    }
+
+    // A replica that cannot warm up starts in backoff; the primary
+    // keeps serving reads meanwhile.
+    void warm_replicas(const std::vector<std::unique_ptr<ReplicaPool>> &replicas) noexcept
+    {
+      for (const auto &r : replicas)
+      {
+        try
+        {
+          r->pool().warmup();
+        }
+        catch (...)
+        {
+          r->markFailed();
+        }
+      }
+    }
+
     PoolConfig pool_for(const DbConfig &cfg)
     {
       switch (cfg.engine)
@@ -91,13 +180,215 @@ namespace vix::db
         return cfg.mysql.pool;
       }
     }
+
+    // Functions whose result depends on, or that change, the state of
+    // the session they run in: a replica connection would answer for
+    // another session, or take a lock the primary never sees.
+    bool is_session_function(std::string_view name) noexcept
+    {
+      static constexpr std::string_view kNames[] = {
+          "LAST_INSERT_ID", "ROW_COUNT", "FOUND_ROWS", "CONNECTION_ID",
+          "GET_LOCK", "RELEASE_LOCK", "RELEASE_ALL_LOCKS", "IS_FREE_LOCK", "IS_USED_LOCK",
+          "NEXTVAL", "SETVAL", "LASTVAL"};
+      for (const auto k : kNames)
+      {
+        if (detail::iequals(name, k))
+          return true;
+      }
+      return false;
+    }
   } // namespace
 
   Database::Database(const DbConfig &cfg)
       : cfg_(cfg),
-        pool_(make_factory_for(cfg), pool_for(cfg))
+        pool_(make_factory_for(cfg), pool_for(cfg)),
+        replicas_(make_replicas(cfg)),
+        ready_(ready_promise_.get_future().share())
+  {
+    if (cfg_.startup == Startup::Blocking)
+    {
+      pool_.warmup();
+      warm_replicas(replicas_);
+      ready_promise_.set_value();
+      return;
+    }
+
+    warmer_ = std::thread([this]
+                          {
+      std::atomic<bool> signalled{false};
+      try
+      {
+        pool_.warmup([&]
+                     {
+          signalled = true;
+          ready_promise_.set_value(); });
+      }
+      catch (...)
+      {
+        // Connections that did come up already made the pool usable.
+        if (!signalled)
+          ready_promise_.set_exception(std::current_exception());
+      }
+      warm_replicas(replicas_); });
+  }
+
+  Database::~Database()
+  {
+    if (warmer_.joinable())
+      warmer_.join();
+  }
+
+  RoutedConn Database::writer()
+  {
+    return RoutedConn(PooledConn(pool_), nullptr);
+  }
+
+  RoutedConn Database::reader()
+  {
+    const std::size_t n = replicas_.size();
+
+    // Each failed attempt puts its replica in backoff, so this tries
+    // every replica at most once before falling back to the primary.
+    for (std::size_t attempt = 0; attempt < n; ++attempt)
+    {
+      // Least outstanding leases; the rotating start spreads ties.
+      const std::size_t start = next_replica_.fetch_add(1, std::memory_order_relaxed);
+      ReplicaPool *best = nullptr;
+      std::size_t best_load = 0;
+
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        ReplicaPool *r = replicas_[(start + k) % n].get();
+        if (!r->healthy())
+          continue;
+
+        const std::size_t load = r->outstanding();
+        if (!best || load < best_load)
+        {
+          best = r;
+          best_load = load;
+        }
+      }
+
+      if (!best)
+        break;
+
+      try
+      {
+        return best->lease();
+      }
+      catch (const PoolTimeout &)
+      {
+        throw;
+      }
+      catch (...)
+      {
+        // lease() marked the replica failed; try the next one.
+      }
+    }
+
+    return writer();
+  }
+
+  RoutedConn Database::route(std::string_view sql)
+  {
+    return is_read_only_sql(sql) ? reader() : writer();
+  }
+
+  std::vector<std::pair<std::string, PoolStats>> Database::poolStats() const
+  {
+    std::vector<std::pair<std::string, PoolStats>> out;
+    out.reserve(1 + replicas_.size());
+    out.emplace_back("primary", pool_.stats());
+    for (const auto &r : replicas_)
+      out.emplace_back(r->name(), r->pool().stats());
+    return out;
+  }
+
+  bool is_read_only_sql(std::string_view sql) noexcept
+  {
+    const std::size_t n = sql.size();
+    std::size_t i = 0;
+
+    // Leading blanks, comments and opening parentheses.
+    while (i < n)
+    {
+      const char c = sql[i];
+      if (std::isspace(static_cast<unsigned char>(c)) || c == '(')
+      {
+        ++i;
+        continue;
+      }
+      const bool quoted = c == '\'' || c == '"' || c == '`';
+      const std::size_t next = quoted ? i : detail::skip_ignored(sql, i);
+      if (next == i)
+        break;
+      i = next;
+    }
+
+    std::size_t j = detail::word_end(sql, i);
+    const auto verb = sql.substr(i, j - i);
+
+    if (detail::iequals(verb, "SHOW") || detail::iequals(verb, "DESCRIBE") ||
+        detail::iequals(verb, "DESC"))
+      return true;
+    if (!detail::iequals(verb, "SELECT"))
+      return false;
+
+    // Reject locking reads, SELECT ... INTO, session functions and user
+    // variables (read or assigned, they live in one session), skipping
+    // quoted text and comments. @@system variables are fine.
+    std::string_view prev;
+    while (j < n)
+    {
+      if (const auto next = detail::skip_ignored(sql, j); next != j)
+      {
+        j = next;
+        continue;
+      }
+      const char c = sql[j];
+      if (c == '@')
+      {
+        if (j + 1 < n && sql[j + 1] == '@')
+        {
+          j += 2;
+          continue;
+        }
+        return false;
+      }
+      if (c == ':' && j + 1 < n && sql[j + 1] == '=')
+        return false;
+      if (!detail::is_word_char(c))
+      {
+        ++j;
+        continue;
+      }
+
+      const std::size_t w = j;
+      j = detail::word_end(sql, j);
+      const auto word = sql.substr(w, j - w);
+
+      if (detail::iequals(word, "INTO") || detail::iequals(word, "LOCK"))
+        return false;
+      if (is_session_function(word))
+      {
+        std::size_t k = j;
+        while (k < n && std::isspace(static_cast<unsigned char>(sql[k])))
+          ++k;
+        if (k < n && sql[k] == '(')
+          return false;
+      }
+      if (detail::iequals(prev, "FOR") &&
+          (detail::iequals(word, "UPDATE") || detail::iequals(word, "SHARE")))
+        return false;
+      prev = word;
+    }
+    return true;
+  }
+
+  std::string render_prometheus(const Database &db)
   {
-    pool_.warmup();
+    return render_prometheus(db.poolStats());
   }
 
 } // namespace vix::db
@@ -0,0 +1,78 @@
+/**
+ *
+ *  @file DbExecutor.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/async/DbExecutor.hpp>
+#include <vix/db/core/Errors.hpp>
+
+#include <algorithm>
+
+namespace vix::db
+{
+  DbExecutor::DbExecutor(std::size_t threads)
+  {
+    const std::size_t n = std::max<std::size_t>(threads, 1);
+    workers_.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+      workers_.emplace_back([this]
+                            { run(); });
+  }
+
+  DbExecutor::~DbExecutor()
+  {
+    {
+      std::lock_guard lk(m_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+
+    for (auto &t : workers_)
+      t.join();
+  }
+
+  void DbExecutor::post(std::function<void()> task)
+  {
+    {
+      std::lock_guard lk(m_);
+      if (stop_)
+        throw DBError("DbExecutor::post after shutdown");
+      tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+  }
+
+  void DbExecutor::run()
+  {
+    for (;;)
+    {
+      std::function<void()> task;
+      {
+        std::unique_lock lk(m_);
+        cv_.wait(lk, [&]
+                 { return stop_ || !tasks_.empty(); });
+        if (tasks_.empty())
+          return;
+
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+
+      try
+      {
+        task();
+      }
+      catch (...)
+      {
+      }
+    }
+  }
+
+} // namespace vix::db
@@ -0,0 +1,171 @@
+/**
+ *
+ *  @file BulkInsert.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/core/BulkInsert.hpp>
+#include <vix/db/core/Drivers.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+
+namespace vix::db
+{
+  std::string quote_identifier(std::string_view name, char quote)
+  {
+    std::string out;
+    out.reserve(name.size() + 4);
+    out.push_back(quote);
+    for (char c : name)
+    {
+      if (c == '.')
+      {
+        out.push_back(quote);
+        out.push_back('.');
+        out.push_back(quote);
+        continue;
+      }
+      if (c == quote)
+        out.push_back(quote);
+      out.push_back(c);
+    }
+    out.push_back(quote);
+    return out;
+  }
+
+  std::string multi_row_insert_sql(std::string_view table,
+                                   std::span<const std::string> columns,
+                                   std::size_t rows)
+  {
+    std::string group = "(";
+    for (std::size_t i = 0; i < columns.size(); ++i)
+      group += i ? ", ?" : "?";
+    group += ")";
+
+    std::string sql = "INSERT INTO ";
+    sql.reserve(sql.size() + table.size() + 16 + columns.size() * 16 + rows * (group.size() + 2));
+    sql += table;
+    sql += " (";
+    for (std::size_t i = 0; i < columns.size(); ++i)
+    {
+      if (i)
+        sql += ", ";
+      sql += columns[i];
+    }
+    sql += ") VALUES ";
+    for (std::size_t r = 0; r < rows; ++r)
+    {
+      if (r)
+        sql += ", ";
+      sql += group;
+    }
+    return sql;
+  }
+
+  std::size_t bound_size(const DbValue &v) noexcept
+  {
+    return std::visit(
+        [](const auto &val) -> std::size_t
+        {
+          using T = std::decay_t<decltype(val)>;
+          if constexpr (std::is_same_v<T, std::string>)
+            return val.size();
+          else if constexpr (std::is_same_v<T, Blob>)
+            return val.bytes.size();
+          else if constexpr (std::is_same_v<T, std::nullptr_t>)
+            return 0;
+          else if constexpr (std::is_same_v<T, Timestamp>)
+            return 26; // "YYYY-MM-DD HH:MM:SS.ffffff"
+          else if constexpr (std::is_same_v<T, Decimal>)
+            return 40; // 38 digits, sign and point
+          else if constexpr (std::is_same_v<T, Date> || std::is_same_v<T, Uuid>)
+            return 16;
+          else
+            return 8;
+        },
+        v);
+  }
+
+  std::uint64_t Connection::insertMany(std::string_view table,
+                                       const std::vector<std::string> &columns,
+                                       const ParamBatch &rows)
+  {
+    const std::size_t width = columns.size();
+    if (width == 0)
+      throw DBError("insertMany: no columns");
+    if (rows.width() != width)
+      throw DBError("insertMany: row width does not match the column list");
+    if (rows.empty())
+      return 0;
+
+    const InsertLimits limits = insertLimits();
+    const std::size_t max_rows = std::min(kMaxInsertRows, limits.max_params / width);
+    if (max_rows == 0)
+      throw DBError("insertMany: too many columns for one statement");
+
+    const char q = identifierQuote();
+    const std::string quoted_table = quote_identifier(table, q);
+    std::vector<std::string> quoted_columns;
+    quoted_columns.reserve(width);
+    for (const auto &c : columns)
+      quoted_columns.push_back(quote_identifier(c, q));
+
+    // SQL text of one more row: "(?, ?), " plus a type tag per value.
+    const std::size_t row_overhead = 3 * width + 2 + 2 * width;
+    const std::size_t header = multi_row_insert_sql(quoted_table, quoted_columns, 0).size();
+
+    std::unordered_map<std::size_t, std::string> shapes;
+    std::uint64_t total = 0;
+
+    for (std::size_t first = 0; first < rows.size();)
+    {
+      std::size_t count = std::min(max_rows, rows.size() - first);
+
+      if (limits.max_bytes != 0)
+      {
+        std::size_t bytes = header;
+        std::size_t fit = 0;
+        for (; fit < count; ++fit)
+        {
+          std::size_t row_bytes = row_overhead;
+          for (const auto &v : rows.row(first + fit))
+            row_bytes += bound_size(v);
+
+          // a single oversized row is still sent, the server reports it
+          if (fit > 0 && bytes + row_bytes > limits.max_bytes)
+            break;
+          bytes += row_bytes;
+        }
+        count = fit;
+      }
+
+      if (count < max_rows)
+        count = std::bit_floor(count);
+
+      auto shape = shapes.find(count);
+      if (shape == shapes.end())
+        shape = shapes.emplace(count, multi_row_insert_sql(quoted_table, quoted_columns, count)).first;
+
+      auto st = prepare(shape->second);
+      const auto values = rows.rows(first, count);
+      for (std::size_t i = 0; i < values.size(); ++i)
+        st->bind(i + 1, values[i]);
+      total += st->exec();
+
+      first += count;
+    }
+
+    return total;
+  }
+
+} // namespace vix::db
@@ -0,0 +1,111 @@
+/**
+ *
+ *  @file ColumnBatch.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/core/ColumnBatch.hpp>
+
+namespace vix::db
+{
+  void ColumnBuffer::reserve(std::size_t rows)
+  {
+    validity_.reserve((rows + 7) / 8);
+    switch (kind_)
+    {
+    case Cell::Kind::Int64:
+      ints_.reserve(rows);
+      break;
+    case Cell::Kind::Double:
+      doubles_.reserve(rows);
+      break;
+    case Cell::Kind::Text:
+    case Cell::Kind::Blob:
+      offsets_.reserve(rows + 1);
+      break;
+    }
+  }
+
+  void ColumnBuffer::append(const Cell &c)
+  {
+    if ((rows_ & 7) == 0)
+      validity_.push_back(0);
+    if (!c.null)
+      validity_.back() = static_cast<std::uint8_t>(validity_.back() | (1u << (rows_ & 7)));
+
+    switch (kind_)
+    {
+    case Cell::Kind::Int64:
+      ints_.push_back(c.null ? 0 : c.i);
+      break;
+    case Cell::Kind::Double:
+      doubles_.push_back(c.null ? 0.0 : c.d);
+      break;
+    case Cell::Kind::Text:
+      if (!c.null)
+        data_.append(c.text);
+      offsets_.push_back(data_.size());
+      break;
+    case Cell::Kind::Blob:
+      if (!c.null)
+        data_.append(reinterpret_cast<const char *>(c.bytes.data()), c.bytes.size());
+      offsets_.push_back(data_.size());
+      break;
+    }
+    ++rows_;
+  }
+
+  ColumnBatch::ColumnBatch(std::initializer_list<Cell::Kind> kinds)
+  {
+    columns_.reserve(kinds.size());
+    cells_.resize(kinds.size());
+    std::size_t i = 0;
+    for (const auto kind : kinds)
+    {
+      columns_.emplace_back(kind);
+      cells_[i++].kind = kind;
+    }
+  }
+
+  void ColumnBatch::clear() noexcept
+  {
+    for (auto &c : columns_)
+      c.clear();
+    rows_ = 0;
+  }
+
+  void ColumnBatch::reserve(std::size_t rows)
+  {
+    for (auto &c : columns_)
+      c.reserve(rows);
+  }
+
+  void ColumnBatch::append(const ResultRow &row)
+  {
+    row.decode(cells_);
+    for (std::size_t i = 0; i < columns_.size(); ++i)
+      columns_[i].append(cells_[i]);
+    ++rows_;
+  }
+
+  std::size_t ResultSet::fetchColumns(ColumnBatch &batch, std::size_t max_rows)
+  {
+    batch.clear();
+    batch.reserve(max_rows);
+
+    std::size_t n = 0;
+    while (n < max_rows && next())
+    {
+      batch.append(row());
+      ++n;
+    }
+    return n;
+  }
+
+} // namespace vix::db
@@ -0,0 +1,329 @@
+/**
+ *
+ *  @file Prefetch.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/core/Prefetch.hpp>
+
+#include <charconv>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <variant>
+
+namespace vix::db
+{
+  namespace
+  {
+    constexpr std::size_t kReadyBatches = 2;
+
+    /// Row over values copied out of a driver row
+    class ValueRow final : public ResultRow
+    {
+      std::span<const DbValue> values_;
+      const ColumnTable *columns_ = nullptr;
+      mutable std::vector<std::string> scratch_; // text of non-text values
+
+      std::string_view format(std::size_t i) const
+      {
+        std::string &s = scratch_[i];
+        s.clear();
+        std::visit([&](const auto &v)
+                   {
+                     using T = std::decay_t<decltype(v)>;
+                     if constexpr (std::is_same_v<T, bool>)
+                       s = v ? "1" : "0";
+                     else if constexpr (std::is_same_v<T, std::int64_t> || std::is_same_v<T, double>)
+                     {
+                       char buf[32];
+                       const auto r = std::to_chars(buf, buf + sizeof buf, v);
+                       s.assign(buf, r.ptr);
+                     }
+                     else if constexpr (std::is_same_v<T, Timestamp> || std::is_same_v<T, Date> ||
+                                        std::is_same_v<T, Decimal> || std::is_same_v<T, Uuid>)
+                       s = to_string(v); },
+                   values_[i]);
+        return s;
+      }
+
+      template <typename T>
+      T number(std::size_t i) const
+      {
+        return std::visit([](const auto &v) -> T
+                          {
+                            using V = std::decay_t<decltype(v)>;
+                            if constexpr (std::is_same_v<V, bool> || std::is_same_v<V, std::int64_t> ||
+                                          std::is_same_v<V, double>)
+                              return static_cast<T>(v);
+                            else if constexpr (std::is_same_v<V, Timestamp>)
+                              return static_cast<T>(v.micros);
+                            else if constexpr (std::is_same_v<V, Date>)
+                              return static_cast<T>(v.days);
+                            else if constexpr (std::is_same_v<V, Decimal>)
+                              return static_cast<T>(to_double(v));
+                            else if constexpr (std::is_same_v<V, std::string>)
+                            {
+                              T out{};
+                              std::from_chars(v.data(), v.data() + v.size(), out);
+                              return out;
+                            }
+                            else
+                              return T{}; },
+                          values_[i]);
+      }
+
+    public:
+      void reset(std::span<const DbValue> values, const ColumnTable &columns)
+      {
+        values_ = values;
+        columns_ = &columns;
+        if (scratch_.size() < values.size())
+          scratch_.resize(values.size());
+      }
+
+      bool isNull(std::size_t i) const override
+      {
+        return std::holds_alternative<std::nullptr_t>(values_[i]);
+      }
+
+      std::string getString(std::size_t i) const override
+      {
+        return std::string(getStringView(i));
+      }
+
+      std::string_view getStringView(std::size_t i) const override
+      {
+        if (const auto *s = std::get_if<std::string>(&values_[i]))
+          return *s;
+        if (const auto *b = std::get_if<Blob>(&values_[i]))
+          return {reinterpret_cast<const char *>(b->bytes.data()), b->bytes.size()};
+        return format(i);
+      }
+
+      std::span<const std::byte> getBlob(std::size_t i) const override
+      {
+        if (const auto *b = std::get_if<Blob>(&values_[i]))
+          return std::as_bytes(std::span(b->bytes));
+        return std::as_bytes(std::span(getStringView(i)));
+      }
+
+      std::int64_t getInt64(std::size_t i) const override { return number<std::int64_t>(i); }
+
+      double getDouble(std::size_t i) const override { return number<double>(i); }
+
+      DbValue getValue(std::size_t i) const override { return values_[i]; }
+
+      Cell getCell(std::size_t i) const override
+      {
+        Cell c;
+        std::visit([&](const auto &v)
+                   {
+                     using T = std::decay_t<decltype(v)>;
+                     if constexpr (std::is_same_v<T, std::nullptr_t>)
+                       c.null = true;
+                     else if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, std::int64_t>)
+                     {
+                       c.kind = Cell::Kind::Int64;
+                       c.i = static_cast<std::int64_t>(v);
+                     }
+                     else if constexpr (std::is_same_v<T, Timestamp>)
+                     {
+                       c.kind = Cell::Kind::Int64;
+                       c.i = v.micros;
+                     }
+                     else if constexpr (std::is_same_v<T, Date>)
+                     {
+                       c.kind = Cell::Kind::Int64;
+                       c.i = v.days;
+                     }
+                     else if constexpr (std::is_same_v<T, Decimal>)
+                     {
+                       c.kind = Cell::Kind::Text;
+                       c.text = format(i);
+                     }
+                     else if constexpr (std::is_same_v<T, double>)
+                     {
+                       c.kind = Cell::Kind::Double;
+                       c.d = v;
+                     }
+                     else if constexpr (std::is_same_v<T, std::string>)
+                     {
+                       c.kind = Cell::Kind::Text;
+                       c.text = v;
+                     }
+                     else // Blob, Uuid
+                     {
+                       c.kind = Cell::Kind::Blob;
+                       c.bytes = std::as_bytes(std::span(v.bytes));
+                     } },
+                   values_[i]);
+        return c;
+      }
+
+      const ColumnTable &columns() const override { return *columns_; }
+    };
+
+    /**
+     * @brief Result set read ahead by a helper thread.
+     *
+     * The helper fills batches of row-major values and queues at most
+     * kReadyBatches of them; the consumer swaps in the next batch when
+     * it reaches the end of the current one and hands the drained one
+     * back for reuse, so the buffers are allocated once per scan.
+     */
+    class PrefetchResultSet final : public ResultSet
+    {
+      struct Batch
+      {
+        std::vector<DbValue> values;
+        std::size_t rows = 0;
+      };
+
+      std::unique_ptr<ResultSet> source_;
+      ColumnTable columns_;
+      std::size_t width_;
+      std::size_t batch_rows_;
+
+      std::mutex mutex_;
+      std::condition_variable cv_;
+      std::deque<Batch> ready_;
+      std::vector<Batch> free_;
+      bool finished_ = false;
+      bool stop_ = false;
+      std::exception_ptr error_;
+
+      Batch current_;
+      std::size_t pos_ = 0;
+      ValueRow row_;
+
+      std::thread worker_;
+
+      void run()
+      {
+        for (;;)
+        {
+          Batch batch;
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!free_.empty())
+            {
+              batch = std::move(free_.back());
+              free_.pop_back();
+            }
+          }
+
+          // rows read before a driver error are still delivered
+          std::exception_ptr error;
+          batch.values.clear();
+          batch.rows = 0;
+          try
+          {
+            batch.values.reserve(batch_rows_ * width_);
+            while (batch.rows < batch_rows_ && source_->next())
+            {
+              const ResultRow &r = source_->row();
+              for (std::size_t i = 0; i < width_; ++i)
+                batch.values.push_back(r.getValue(i));
+              ++batch.rows;
+            }
+          }
+          catch (...)
+          {
+            error = std::current_exception();
+            batch.values.resize(batch.rows * width_);
+          }
+          const bool last = error || batch.rows < batch_rows_;
+
+          std::unique_lock<std::mutex> lock(mutex_);
+          cv_.wait(lock, [&]
+                   { return stop_ || ready_.size() < kReadyBatches; });
+          if (stop_)
+            return;
+          if (batch.rows > 0)
+            ready_.push_back(std::move(batch));
+          error_ = error;
+          finished_ = last;
+          cv_.notify_all();
+          if (last)
+            return;
+        }
+      }
+
+    public:
+      PrefetchResultSet(std::unique_ptr<ResultSet> source, std::size_t batch_rows)
+          : source_(std::move(source)),
+            columns_(source_->columns()),
+            width_(columns_.size()),
+            batch_rows_(batch_rows > 0 ? batch_rows : 1)
+      {
+        worker_ = std::thread([this]
+                              { run(); });
+      }
+
+      ~PrefetchResultSet() override
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          stop_ = true;
+        }
+        cv_.notify_all();
+        worker_.join();
+      }
+
+      bool next() override
+      {
+        if (++pos_ < current_.rows)
+        {
+          row_.reset(std::span(current_.values).subspan(pos_ * width_, width_), columns_);
+          return true;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (current_.values.capacity() > 0)
+          free_.push_back(std::move(current_));
+        current_ = Batch{};
+
+        cv_.wait(lock, [&]
+                 { return !ready_.empty() || finished_; });
+        if (ready_.empty())
+        {
+          if (error_)
+            std::rethrow_exception(error_);
+          return false;
+        }
+
+        current_ = std::move(ready_.front());
+        ready_.pop_front();
+        cv_.notify_all();
+        lock.unlock();
+
+        pos_ = 0;
+        row_.reset(std::span(current_.values).first(width_), columns_);
+        return true;
+      }
+
+      std::size_t cols() const override { return width_; }
+
+      const ColumnTable &columns() const override { return columns_; }
+
+      const ResultRow &row() const override { return row_; }
+    };
+  } // namespace
+
+  std::unique_ptr<ResultSet> prefetch(std::unique_ptr<ResultSet> source, std::size_t batch_rows)
+  {
+    if (!source)
+      throw DBError("prefetch: null result set");
+    return std::make_unique<PrefetchResultSet>(std::move(source), batch_rows);
+  }
+
+} // namespace vix::db
@@ -0,0 +1,469 @@
+/**
+ *
+ *  @file RowBuffer.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/core/RowBuffer.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace vix::db
+{
+  // Row layout: width+1 uint32 offsets from the row start, then one
+  // cell per column. Cell c spans [off[c], off[c+1]): a Tag byte, then
+  // 8 bytes for Int64 and Double, or the raw text or blob bytes.
+  namespace
+  {
+    enum class Tag : std::uint8_t
+    {
+      Null,
+      Int64,
+      Double,
+      Text,
+      Blob
+    };
+
+    constexpr std::size_t kFirstChunk = 64 * 1024;
+    constexpr std::size_t kMaxChunk = 4 * 1024 * 1024;
+
+    std::uint32_t load_u32(const std::byte *p) noexcept
+    {
+      std::uint32_t v;
+      std::memcpy(&v, p, sizeof v);
+      return v;
+    }
+
+    void store_u32(std::byte *p, std::size_t v) noexcept
+    {
+      const auto u = static_cast<std::uint32_t>(v);
+      std::memcpy(p, &u, sizeof u);
+    }
+
+    std::size_t payload_size(const Cell &c) noexcept
+    {
+      if (c.null)
+        return 0;
+      switch (c.kind)
+      {
+      case Cell::Kind::Int64:
+      case Cell::Kind::Double:
+        return 8;
+      case Cell::Kind::Text:
+        return c.text.size();
+      case Cell::Kind::Blob:
+        return c.bytes.size();
+      }
+      return 0;
+    }
+
+    Tag tag_of(const Cell &c) noexcept
+    {
+      if (c.null)
+        return Tag::Null;
+      switch (c.kind)
+      {
+      case Cell::Kind::Int64:
+        return Tag::Int64;
+      case Cell::Kind::Double:
+        return Tag::Double;
+      case Cell::Kind::Text:
+        return Tag::Text;
+      case Cell::Kind::Blob:
+        return Tag::Blob;
+      }
+      return Tag::Null;
+    }
+
+    std::byte *write_cell(std::byte *p, const Cell &c) noexcept
+    {
+      *p++ = static_cast<std::byte>(tag_of(c));
+      if (c.null)
+        return p;
+
+      switch (c.kind)
+      {
+      case Cell::Kind::Int64:
+        std::memcpy(p, &c.i, 8);
+        return p + 8;
+      case Cell::Kind::Double:
+        std::memcpy(p, &c.d, 8);
+        return p + 8;
+      case Cell::Kind::Text:
+        if (!c.text.empty())
+          std::memcpy(p, c.text.data(), c.text.size());
+        return p + c.text.size();
+      case Cell::Kind::Blob:
+        if (!c.bytes.empty())
+          std::memcpy(p, c.bytes.data(), c.bytes.size());
+        return p + c.bytes.size();
+      }
+      return p;
+    }
+  } // namespace
+
+  /**
+   * @brief Chunks holding the encoded rows, shared by every copy.
+   *
+   * Chunks come from the heap until memory_limit bytes are in use,
+   * then from an unlinked file grown and mapped one chunk at a time.
+   * Neither kind ever moves, so rows are addressed by pointer.
+   */
+  struct RowBuffer::Storage
+  {
+    ColumnTable columns;
+    std::vector<const std::byte *> rows;
+    std::size_t bytes = 0;
+
+    std::vector<std::unique_ptr<std::byte[]>> heap;
+    std::size_t heap_bytes = 0;
+
+    int fd = -1;
+    std::size_t file_size = 0;
+    std::vector<std::pair<void *, std::size_t>> maps;
+
+    std::byte *cur = nullptr;
+    std::size_t left = 0;
+    std::size_t next_chunk = kFirstChunk;
+
+    std::size_t memory_limit;
+    std::string spill_dir;
+
+    explicit Storage(const MaterializeOptions &options)
+        : memory_limit(options.memory_limit), spill_dir(options.spill_dir) {}
+
+    ~Storage()
+    {
+#if !defined(_WIN32)
+      for (const auto &[p, n] : maps)
+        ::munmap(p, n);
+      if (fd >= 0)
+        ::close(fd);
+#endif
+    }
+
+    Storage(const Storage &) = delete;
+    Storage &operator=(const Storage &) = delete;
+
+    /**
+     * The row being written lives at cur until commit(). Makes room for
+     * n bytes after its first used ones, moving those to a fresh chunk
+     * when the current one is too short.
+     *
+     * @return Start of the row, which may have moved.
+     */
+    std::byte *reserve(std::size_t used, std::size_t n)
+    {
+      if (used + n > left)
+      {
+        const std::byte *row = cur;
+        grow(used + n);
+        if (used != 0)
+          std::memcpy(cur, row, used);
+      }
+      return cur;
+    }
+
+    /// Ends the row written at cur, n bytes long.
+    const std::byte *commit(std::size_t n) noexcept
+    {
+      const std::byte *p = cur;
+      cur += n;
+      left -= n;
+      bytes += n;
+      return p;
+    }
+
+  private:
+    void grow(std::size_t n)
+    {
+      const std::size_t size = std::max(n, next_chunk);
+      next_chunk = std::min(next_chunk * 2, kMaxChunk);
+
+      if (memory_limit == 0 || heap_bytes + size <= memory_limit)
+      {
+        heap.push_back(std::make_unique_for_overwrite<std::byte[]>(size));
+        heap_bytes += size;
+        cur = heap.back().get();
+        left = size;
+        return;
+      }
+      map_chunk(size);
+    }
+
+    void map_chunk(std::size_t n)
+    {
+#if defined(_WIN32)
+      (void)n;
+      throw DBError("RowBuffer: spilling to disk is not supported on this platform");
+#else
+      if (fd < 0)
+        open_spill_file();
+
+      const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      const std::size_t size = (n + page - 1) / page * page;
+
+      if (::ftruncate(fd, static_cast<off_t>(file_size + size)) != 0)
+        throw DBError("RowBuffer: cannot grow spill file");
+
+      void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+                       static_cast<off_t>(file_size));
+      if (p == MAP_FAILED)
+        throw DBError("RowBuffer: cannot map spill file");
+
+      maps.emplace_back(p, size);
+      file_size += size;
+      cur = static_cast<std::byte *>(p);
+      left = size;
+#endif
+    }
+
+#if !defined(_WIN32)
+    void open_spill_file()
+    {
+      const std::filesystem::path dir =
+          spill_dir.empty() ? std::filesystem::temp_directory_path()
+                            : std::filesystem::path(spill_dir);
+      std::string path = (dir / "vixdb-rows-XXXXXX").string();
+
+      fd = ::mkstemp(path.data());
+      if (fd < 0)
+        throw DBError("RowBuffer: cannot create spill file in " + dir.string());
+
+      // Removed right away: the space is released with the descriptor.
+      ::unlink(path.c_str());
+    }
+#endif
+  };
+
+  RowBuffer::RowBuffer(ResultSet &source, const MaterializeOptions &options)
+  {
+    auto data = std::make_shared<Storage>(options);
+    data->columns = source.columns();
+
+    const std::size_t width = data->columns.size();
+    const std::size_t header = (width + 1) * sizeof(std::uint32_t);
+
+    // Each cell is encoded into the arena as soon as it is read, so its
+    // views need not outlive the read of the next column. A row only
+    // moves when it runs past the end of a chunk.
+    while (source.next())
+    {
+      const ResultRow &r = source.row();
+
+      std::byte *row = data->reserve(0, header);
+      std::size_t used = header;
+      for (std::size_t i = 0; i < width; ++i)
+      {
+        const Cell c = r.getCell(i);
+        const std::size_t size = used + 1 + payload_size(c);
+        if (size > std::numeric_limits<std::uint32_t>::max())
+          throw DBError("RowBuffer: row larger than 4 GiB");
+
+        row = data->reserve(used, size - used);
+        store_u32(row + i * sizeof(std::uint32_t), used);
+        write_cell(row + used, c);
+        used = size;
+      }
+      store_u32(row + width * sizeof(std::uint32_t), used);
+      data->rows.push_back(data->commit(used));
+    }
+
+    data_ = std::move(data);
+  }
+
+  std::size_t RowBuffer::size() const noexcept { return data_->rows.size(); }
+
+  std::size_t RowBuffer::bytes() const noexcept { return data_->bytes; }
+
+  bool RowBuffer::spilled() const noexcept { return data_->fd >= 0; }
+
+  const ColumnTable &RowBuffer::columns() const { return data_->columns; }
+
+  bool RowBuffer::next()
+  {
+    if (next_ >= data_->rows.size())
+      return false;
+    row_.reset(data_->rows[next_++], data_->columns);
+    return true;
+  }
+
+  // -------------------- Row --------------------
+
+  void RowBuffer::Row::reset(const std::byte *data, const ColumnTable &columns)
+  {
+    data_ = data;
+    columns_ = &columns;
+    if (scratch_.size() < columns.size())
+      scratch_.resize(columns.size());
+  }
+
+  Cell RowBuffer::Row::getCell(std::size_t i) const
+  {
+    const std::byte *off = data_ + i * sizeof(std::uint32_t);
+    const std::byte *p = data_ + load_u32(off);
+    const std::size_t n = load_u32(off + sizeof(std::uint32_t)) - load_u32(off) - 1;
+
+    Cell c;
+    switch (static_cast<Tag>(*p++))
+    {
+    case Tag::Null:
+      c.null = true;
+      break;
+    case Tag::Int64:
+      c.kind = Cell::Kind::Int64;
+      std::memcpy(&c.i, p, 8);
+      break;
+    case Tag::Double:
+      c.kind = Cell::Kind::Double;
+      std::memcpy(&c.d, p, 8);
+      break;
+    case Tag::Text:
+      c.kind = Cell::Kind::Text;
+      c.text = {reinterpret_cast<const char *>(p), n};
+      break;
+    case Tag::Blob:
+      c.kind = Cell::Kind::Blob;
+      c.bytes = {p, n};
+      break;
+    }
+    return c;
+  }
+
+  bool RowBuffer::Row::isNull(std::size_t i) const
+  {
+    return getCell(i).null;
+  }
+
+  std::string RowBuffer::Row::getString(std::size_t i) const
+  {
+    return std::string(getStringView(i));
+  }
+
+  std::string_view RowBuffer::Row::getStringView(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return {};
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Text:
+      return c.text;
+    case Cell::Kind::Blob:
+      return {reinterpret_cast<const char *>(c.bytes.data()), c.bytes.size()};
+    default:
+    {
+      char buf[32];
+      const auto r = c.kind == Cell::Kind::Int64
+                         ? std::to_chars(buf, buf + sizeof buf, c.i)
+                         : std::to_chars(buf, buf + sizeof buf, c.d);
+      scratch_[i].assign(buf, r.ptr);
+      return scratch_[i];
+    }
+    }
+  }
+
+  std::span<const std::byte> RowBuffer::Row::getBlob(std::size_t i) const
+  {
+    return std::as_bytes(std::span(getStringView(i)));
+  }
+
+  std::int64_t RowBuffer::Row::getInt64(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return 0;
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return c.i;
+    case Cell::Kind::Double:
+      return static_cast<std::int64_t>(c.d);
+    case Cell::Kind::Text:
+    {
+      std::int64_t v = 0;
+      std::from_chars(c.text.data(), c.text.data() + c.text.size(), v);
+      return v;
+    }
+    case Cell::Kind::Blob:
+      break;
+    }
+    return 0;
+  }
+
+  double RowBuffer::Row::getDouble(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return 0.0;
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return static_cast<double>(c.i);
+    case Cell::Kind::Double:
+      return c.d;
+    case Cell::Kind::Text:
+    {
+      double v = 0.0;
+      std::from_chars(c.text.data(), c.text.data() + c.text.size(), v);
+      return v;
+    }
+    case Cell::Kind::Blob:
+      break;
+    }
+    return 0.0;
+  }
+
+  DbValue RowBuffer::Row::getValue(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return null();
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return i64(c.i);
+    case Cell::Kind::Double:
+      return f64(c.d);
+    case Cell::Kind::Text:
+      return str(std::string(c.text));
+    case Cell::Kind::Blob:
+      break;
+    }
+    const auto *p = reinterpret_cast<const std::uint8_t *>(c.bytes.data());
+    return blob(std::vector<std::uint8_t>(p, p + c.bytes.size()));
+  }
+
+  // -------------------- ResultSet --------------------
+
+  RowBuffer ResultSet::materialize()
+  {
+    return RowBuffer(*this);
+  }
+
+  RowBuffer ResultSet::materialize(const MaterializeOptions &options)
+  {
+    return RowBuffer(*this, options);
+  }
+
+} // namespace vix::db
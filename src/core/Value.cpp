@@ -0,0 +1,487 @@
+/**
+ *
+ *  @file Value.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/core/Value.hpp>
+
+#include <vix/db/core/Errors.hpp>
+#include <vix/db/core/Result.hpp>
+
+#include <charconv>
+#include <cmath>
+
+namespace vix::db
+{
+  namespace
+  {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+#else
+    using uint128 = std::_Unsigned128;
+#endif
+
+    constexpr std::int64_t kMicrosPerDay = 86'400'000'000;
+    constexpr std::uint64_t kPow18 = 1'000'000'000'000'000'000ull;
+
+    // Fixed-width decimal digits, right-aligned in [p, p + width)
+    char *put_digits(char *p, unsigned v, int width) noexcept
+    {
+      for (int k = width - 1; k >= 0; --k)
+      {
+        p[k] = static_cast<char>('0' + v % 10);
+        v /= 10;
+      }
+      return p + width;
+    }
+
+    char *put_date(char *p, std::chrono::year_month_day ymd) noexcept
+    {
+      int y = static_cast<int>(ymd.year());
+      if (y < 0)
+      {
+        *p++ = '-';
+        y = -y;
+      }
+      if (y > 9999)
+        p = std::to_chars(p, p + 8, y).ptr;
+      else
+        p = put_digits(p, static_cast<unsigned>(y), 4);
+      *p++ = '-';
+      p = put_digits(p, static_cast<unsigned>(ymd.month()), 2);
+      *p++ = '-';
+      return put_digits(p, static_cast<unsigned>(ymd.day()), 2);
+    }
+
+    [[noreturn]] void bad_value(const char *what, std::string_view s)
+    {
+      throw DBError(std::string("invalid ") + what + ": '" + std::string(s) + "'");
+    }
+
+    // Reads exactly n digits at s[i], advancing i.
+    bool read_digits(std::string_view s, std::size_t &i, std::size_t n, int &out) noexcept
+    {
+      if (i + n > s.size())
+        return false;
+      int v = 0;
+      for (std::size_t k = 0; k < n; ++k)
+      {
+        const char c = s[i + k];
+        if (c < '0' || c > '9')
+          return false;
+        v = v * 10 + (c - '0');
+      }
+      out = v;
+      i += n;
+      return true;
+    }
+
+    bool read_char(std::string_view s, std::size_t &i, char c) noexcept
+    {
+      if (i < s.size() && s[i] == c)
+      {
+        ++i;
+        return true;
+      }
+      return false;
+    }
+
+    // "YYYY-MM-DD" at the start of s; i is left just past it. As written
+    // by put_date, the year may be negative or have more than 4 digits.
+    bool read_date(std::string_view s, std::size_t &i, std::chrono::sys_days &out) noexcept
+    {
+      const bool negative = read_char(s, i, '-');
+      std::size_t width = 0;
+      while (i + width < s.size() && width < 6 && s[i + width] >= '0' && s[i + width] <= '9')
+        ++width;
+
+      int y = 0, m = 0, d = 0;
+      if (width < 4 || !read_digits(s, i, width, y) || !read_char(s, i, '-') ||
+          !read_digits(s, i, 2, m) || !read_char(s, i, '-') ||
+          !read_digits(s, i, 2, d))
+        return false;
+
+      if (y > static_cast<int>(std::chrono::year::max()))
+        return false;
+      if (negative)
+        y = -y;
+      const std::chrono::year_month_day ymd{std::chrono::year(y),
+                                            std::chrono::month(static_cast<unsigned>(m)),
+                                            std::chrono::day(static_cast<unsigned>(d))};
+      if (!ymd.ok())
+        return false;
+      out = std::chrono::sys_days(ymd);
+      return true;
+    }
+
+    int hex_value(char c) noexcept
+    {
+      if (c >= '0' && c <= '9')
+        return c - '0';
+      if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+      return -1;
+    }
+  } // namespace
+
+  // -------------------- Formatting --------------------
+
+  std::string to_string(Timestamp v)
+  {
+    // floor division, so instants before 1970 fall on the right day
+    std::int64_t days = v.micros / kMicrosPerDay;
+    std::int64_t rem = v.micros % kMicrosPerDay;
+    if (rem < 0)
+    {
+      rem += kMicrosPerDay;
+      --days;
+    }
+
+    char buf[40];
+    char *p = put_date(buf, std::chrono::year_month_day(
+                                std::chrono::sys_days(std::chrono::days(days))));
+
+    const auto secs = static_cast<unsigned>(rem / 1'000'000);
+    const auto frac = static_cast<unsigned>(rem % 1'000'000);
+    *p++ = ' ';
+    p = put_digits(p, secs / 3600, 2);
+    *p++ = ':';
+    p = put_digits(p, secs / 60 % 60, 2);
+    *p++ = ':';
+    p = put_digits(p, secs % 60, 2);
+    if (frac != 0)
+    {
+      *p++ = '.';
+      p = put_digits(p, frac, 6);
+    }
+    return std::string(buf, p);
+  }
+
+  std::string to_string(Date v)
+  {
+    char buf[16];
+    char *p = put_date(buf, std::chrono::year_month_day(v.day()));
+    return std::string(buf, p);
+  }
+
+  std::string to_string(const Decimal &v)
+  {
+    const bool negative = v.unscaled < 0;
+    uint128 u = negative ? uint128(0) - static_cast<uint128>(v.unscaled)
+                         : static_cast<uint128>(v.unscaled);
+
+    // Digits in reverse, 18 at a time so most steps are 64-bit; at most
+    // 39 significant digits, or scale + 1 with the zero padding below.
+    char digits[256];
+    std::size_t n = 0;
+    do
+    {
+      auto chunk = static_cast<std::uint64_t>(u % kPow18);
+      u /= kPow18;
+      for (int k = 0; k < 18 && (chunk != 0 || u != 0); ++k)
+      {
+        digits[n++] = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+      }
+    } while (u != 0);
+    while (n <= v.scale)
+      digits[n++] = '0';
+
+    std::string out;
+    out.reserve(n + 2);
+    if (negative)
+      out.push_back('-');
+    for (std::size_t k = n; k-- > 0;)
+    {
+      out.push_back(digits[k]);
+      if (k == v.scale && k != 0)
+        out.push_back('.');
+    }
+    return out;
+  }
+
+  std::string to_string(const Uuid &v)
+  {
+    static constexpr char kHex[] = "0123456789abcdef";
+    std::string out;
+    out.reserve(36);
+    for (std::size_t k = 0; k < 16; ++k)
+    {
+      if (k == 4 || k == 6 || k == 8 || k == 10)
+        out.push_back('-');
+      out.push_back(kHex[v.bytes[k] >> 4]);
+      out.push_back(kHex[v.bytes[k] & 0xf]);
+    }
+    return out;
+  }
+
+  // -------------------- Parsing --------------------
+
+  Timestamp parse_timestamp(std::string_view s)
+  {
+    std::size_t i = 0;
+    std::chrono::sys_days day;
+    if (!read_date(s, i, day))
+      bad_value("timestamp", s);
+
+    std::int64_t micros = day.time_since_epoch().count() * kMicrosPerDay;
+    if (i == s.size())
+      return {micros};
+
+    int hh = 0, mm = 0, ss = 0;
+    if (!(read_char(s, i, ' ') || read_char(s, i, 'T')) ||
+        !read_digits(s, i, 2, hh) || !read_char(s, i, ':') || !read_digits(s, i, 2, mm))
+      bad_value("timestamp", s);
+    if (read_char(s, i, ':') && !read_digits(s, i, 2, ss))
+      bad_value("timestamp", s);
+    if (hh > 23 || mm > 59 || ss > 59)
+      bad_value("timestamp", s);
+    micros += ((hh * 60 + mm) * 60 + ss) * std::int64_t{1'000'000};
+
+    if (read_char(s, i, '.'))
+    {
+      std::int64_t frac = 0;
+      int digits = 0;
+      for (; i < s.size() && s[i] >= '0' && s[i] <= '9'; ++i, ++digits)
+      {
+        if (digits < 6)
+          frac = frac * 10 + (s[i] - '0');
+      }
+      if (digits == 0)
+        bad_value("timestamp", s);
+      for (; digits < 6; ++digits)
+        frac *= 10;
+      micros += frac;
+    }
+
+    if (read_char(s, i, 'Z'))
+    {
+    }
+    else if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+    {
+      const int sign = s[i++] == '-' ? -1 : 1;
+      int oh = 0, om = 0;
+      if (!read_digits(s, i, 2, oh))
+        bad_value("timestamp", s);
+      read_char(s, i, ':');
+      if (i < s.size() && !read_digits(s, i, 2, om))
+        bad_value("timestamp", s);
+      micros -= sign * (oh * 60 + om) * std::int64_t{60'000'000};
+    }
+
+    if (i != s.size())
+      bad_value("timestamp", s);
+    return {micros};
+  }
+
+  Date parse_date(std::string_view s)
+  {
+    std::size_t i = 0;
+    std::chrono::sys_days day;
+    if (!read_date(s, i, day) || (i < s.size() && s[i] != ' ' && s[i] != 'T'))
+      bad_value("date", s);
+    return Date::from(day);
+  }
+
+  Decimal parse_decimal(std::string_view s)
+  {
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-'))
+      negative = s[i++] == '-';
+
+    uint128 u = 0;
+    int significant = 0;
+    int scale = 0;
+    bool any = false;
+    bool point = false;
+    for (; i < s.size(); ++i)
+    {
+      const char c = s[i];
+      if (c == '.' && !point)
+      {
+        point = true;
+        continue;
+      }
+      if (c < '0' || c > '9')
+        bad_value("decimal", s);
+
+      any = true;
+      if (point)
+        ++scale;
+      if (u == 0 && c == '0')
+        continue;
+      if (++significant > 38)
+        bad_value("decimal", s);
+      u = u * 10 + static_cast<unsigned>(c - '0');
+    }
+    if (!any || scale > 255)
+      bad_value("decimal", s);
+
+    const auto v = static_cast<int128>(u);
+    return {negative ? -v : v, static_cast<std::uint8_t>(scale)};
+  }
+
+  Uuid parse_uuid(std::string_view s)
+  {
+    if (s.size() != 36 && s.size() != 32)
+      bad_value("uuid", s);
+
+    Uuid out;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < s.size();)
+    {
+      if (s.size() == 36 && (i == 8 || i == 13 || i == 18 || i == 23))
+      {
+        if (s[i++] != '-')
+          bad_value("uuid", s);
+        continue;
+      }
+      const int hi = hex_value(s[i]);
+      const int lo = hex_value(s[i + 1]);
+      if (hi < 0 || lo < 0)
+        bad_value("uuid", s);
+      out.bytes[k++] = static_cast<std::uint8_t>(hi << 4 | lo);
+      i += 2;
+    }
+    return out;
+  }
+
+  // -------------------- Decimal --------------------
+
+  double to_double(const Decimal &v) noexcept
+  {
+    double scale = 1.0;
+    for (int k = 0; k < v.scale; ++k)
+      scale *= 10.0;
+    return static_cast<double>(v.unscaled) / scale;
+  }
+
+  std::array<std::byte, kDecimalBytes> to_bytes(const Decimal &v) noexcept
+  {
+    std::array<std::byte, kDecimalBytes> out;
+    out[0] = static_cast<std::byte>(v.scale);
+    auto u = static_cast<uint128>(v.unscaled);
+    for (std::size_t k = kDecimalBytes - 1; k > 0; --k)
+    {
+      out[k] = static_cast<std::byte>(static_cast<unsigned>(u & 0xff));
+      u >>= 8;
+    }
+    return out;
+  }
+
+  Decimal decimal_from_bytes(std::span<const std::byte> b)
+  {
+    if (b.size() != kDecimalBytes)
+      throw DBError("invalid decimal: expected 17 bytes, got " + std::to_string(b.size()));
+
+    uint128 u = 0;
+    for (std::size_t k = 1; k < kDecimalBytes; ++k)
+      u = u << 8 | static_cast<unsigned>(b[k]);
+    return {static_cast<int128>(u), static_cast<std::uint8_t>(b[0])};
+  }
+
+  // -------------------- ResultRow typed getters --------------------
+
+  // Storage read back: INTEGER as microseconds or days since the epoch
+  // (SQLite binding), REAL as a Julian day (SQLite date functions),
+  // text in ISO form, blobs in the binary forms above.
+
+  Timestamp ResultRow::getTimestamp(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return {};
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return {c.i};
+    case Cell::Kind::Double:
+      return {static_cast<std::int64_t>(std::llround((c.d - 2440587.5) * 86400e6))};
+    case Cell::Kind::Text:
+      return parse_timestamp(c.text);
+    case Cell::Kind::Blob:
+      break;
+    }
+    return parse_timestamp({reinterpret_cast<const char *>(c.bytes.data()), c.bytes.size()});
+  }
+
+  Date ResultRow::getDate(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return {};
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return {static_cast<std::int32_t>(c.i)};
+    case Cell::Kind::Double:
+      return {static_cast<std::int32_t>(std::floor(c.d - 2440587.5))};
+    case Cell::Kind::Text:
+      return parse_date(c.text);
+    case Cell::Kind::Blob:
+      break;
+    }
+    return parse_date({reinterpret_cast<const char *>(c.bytes.data()), c.bytes.size()});
+  }
+
+  Decimal ResultRow::getDecimal(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return {};
+
+    switch (c.kind)
+    {
+    case Cell::Kind::Int64:
+      return {c.i, 0};
+    case Cell::Kind::Double:
+    {
+      char buf[400];
+      const auto r = std::to_chars(buf, buf + sizeof buf, c.d, std::chars_format::fixed);
+      return parse_decimal({buf, r.ptr});
+    }
+    case Cell::Kind::Text:
+      return parse_decimal(c.text);
+    case Cell::Kind::Blob:
+      break;
+    }
+    return decimal_from_bytes(c.bytes);
+  }
+
+  Uuid ResultRow::getUuid(std::size_t i) const
+  {
+    const Cell c = getCell(i);
+    if (c.null)
+      return {};
+
+    std::span<const std::byte> raw = c.bytes;
+    if (c.kind == Cell::Kind::Text)
+    {
+      if (c.text.size() != 16)
+        return parse_uuid(c.text);
+      raw = std::as_bytes(std::span(c.text));
+    }
+    if (c.kind != Cell::Kind::Text && c.kind != Cell::Kind::Blob)
+      throw DBError("invalid uuid: column " + std::to_string(i) + " is numeric");
+    if (raw.size() != 16)
+      throw DBError("invalid uuid: expected 16 bytes, got " + std::to_string(raw.size()));
+
+    Uuid out;
+    for (std::size_t k = 0; k < 16; ++k)
+      out.bytes[k] = static_cast<std::uint8_t>(raw[k]);
+    return out;
+  }
+
+} // namespace vix::db
@@ -11,31 +11,206 @@
  *  Vix.cpp
  */
 #include <vix/db/core/Errors.hpp>
+#include <vix/db/core/SqlLex.hpp>
 
 #if VIX_DB_HAS_MYSQL
 
 #include <vix/db/drivers/mysql/MySQLDriver.hpp>
 
+#include <cppconn/datatype.h>
 #include <cppconn/statement.h>
 #include <cppconn/prepared_statement.h>
 #include <cppconn/resultset.h>
 
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <istream>
 #include <memory>
+#include <optional>
+#include <streambuf>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace vix::db
 {
+  // MySQL reports every integrity error as SQLSTATE 23000 and lock wait
+  // timeouts as HY000, so the native error number decides first:
+  // ER_DUP_ENTRY, ER_DUP_ENTRY_WITH_KEY_NAME, ER_LOCK_DEADLOCK,
+  // ER_LOCK_WAIT_TIMEOUT, ER_QUERY_TIMEOUT (max_execution_time),
+  // CR_SERVER_GONE_ERROR, CR_SERVER_LOST and CR_SERVER_LOST_EXTENDED.
+  static DbErrorCode classify_mysql(int code, std::string_view state) noexcept
+  {
+    switch (code)
+    {
+    case 1062:
+    case 1586:
+      return DbErrorCode::DuplicateKey;
+    case 1213:
+      return DbErrorCode::Deadlock;
+    case 1205:
+    case 3024:
+      return DbErrorCode::Timeout;
+    case 2006:
+    case 2013:
+    case 2055:
+      return DbErrorCode::ConnectionLost;
+    default:
+      return classify_sqlstate(state);
+    }
+  }
+
+  static ErrorInfo mysql_error(const sql::SQLException &e, const char *prefix)
+  {
+    std::string state = e.getSQLState();
+    const DbErrorCode code = classify_mysql(e.getErrorCode(), state);
+    return ErrorInfo{code, e.getErrorCode(), std::move(state),
+                     std::string(prefix) + ": " + e.what()};
+  }
+
+  [[noreturn]] static void throw_mysql(const sql::SQLException &e, const char *prefix)
+  {
+    raise(mysql_error(e, prefix));
+  }
+
+  // Prepared statement taken from a connection's cache. Shared by the
+  // Statement and the result sets it produced: the handle returns to
+  // the cache, parameters cleared, when the last of them is destroyed.
+  class MySQLStmtLease
+  {
+    MySQLStatementCache *cache_ = nullptr;
+    MySQLStatementCache::Entry entry_;
+
+  public:
+    MySQLStmtLease(MySQLStatementCache *cache, MySQLStatementCache::Entry entry) noexcept
+        : cache_(cache), entry_(std::move(entry)) {}
+
+    ~MySQLStmtLease()
+    {
+      if (!cache_ || !entry_.handle)
+        return;
+
+      try
+      {
+        entry_.handle->clearParameters();
+        cache_->put(std::move(entry_));
+      }
+      catch (...)
+      {
+        // A statement that cannot be cleaned up is dropped.
+      }
+    }
+
+    MySQLStmtLease(const MySQLStmtLease &) = delete;
+    MySQLStmtLease &operator=(const MySQLStmtLease &) = delete;
+
+    sql::PreparedStatement &get() const noexcept { return *entry_.handle; }
+
+    const std::string &sql() const noexcept { return entry_.sql; }
+  };
+
+  // Read-only stream over caller-owned bytes. Handed to setBlob(), it
+  // lets the connector send the payload straight from the caller's
+  // buffer instead of from a SQLString copy.
+  class ViewBuf : public std::streambuf
+  {
+    // The get area is never written through.
+    char *begin_;
+    char *end_;
+
+  public:
+    ViewBuf(const char *p, std::size_t n)
+        : begin_(const_cast<char *>(p)), end_(begin_ + n)
+    {
+      rewind();
+    }
+
+    void rewind() { setg(begin_, begin_, end_); }
+  };
+
+  class ViewStream final : private ViewBuf, public std::istream
+  {
+  public:
+    ViewStream(const char *p, std::size_t n)
+        : ViewBuf(p, n), std::istream(static_cast<std::streambuf *>(this)) {}
+
+    // Every execution reads the parameter from the start.
+    void rewind()
+    {
+      ViewBuf::rewind();
+      clear();
+    }
+  };
+
   class MySQLResultRow final : public ResultRow
   {
     sql::ResultSet *rs_ = nullptr;
 
+    // Connector/C++ only hands out copies; the views returned by
+    // getStringView() and getBlob() point into these, kept for the row.
+    // Sized once per result set: growing the vector would move the
+    // strings and leave views of short (inline) strings dangling.
+    mutable std::vector<sql::SQLString> cells_;
+    mutable std::vector<bool> filled_;
+
+    // Loaded from the result set metadata on first use.
+    mutable std::optional<ColumnTable> columns_;
+    mutable std::vector<int> types_;
+
+    void load_columns() const
+    {
+      sql::ResultSetMetaData *meta = rs_->getMetaData();
+      const unsigned int n = meta->getColumnCount();
+
+      std::vector<ColumnInfo> cols(n);
+      types_.resize(n);
+      for (unsigned int c = 1; c <= n; ++c)
+      {
+        auto &col = cols[c - 1];
+        col.name = meta->getColumnLabel(c);
+        col.type = meta->getColumnTypeName(c);
+        col.nullable = meta->isNullable(c) != sql::ResultSetMetaData::columnNoNulls;
+        types_[c - 1] = meta->getColumnType(c);
+      }
+      columns_.emplace(std::move(cols));
+    }
+
+    void size_cells()
+    {
+      const std::size_t n = rs_ ? rs_->getMetaData()->getColumnCount() : 0;
+      cells_.assign(n, sql::SQLString());
+      filled_.assign(n, false);
+    }
+
+    const sql::SQLString &cell(std::size_t i) const
+    {
+      if (i >= cells_.size())
+        throw DBError("MySQLResultRow: column index out of range");
+      if (!filled_[i])
+      {
+        cells_[i] = rs_->getString(static_cast<unsigned int>(i + 1));
+        filled_[i] = true;
+      }
+      return cells_[i];
+    }
+
   public:
     MySQLResultRow() = default;
-    explicit MySQLResultRow(sql::ResultSet *rs) : rs_(rs) {}
+    explicit MySQLResultRow(sql::ResultSet *rs) : rs_(rs) { size_cells(); }
 
-    void reset(sql::ResultSet *rs) { rs_ = rs; }
+    void reset(sql::ResultSet *rs)
+    {
+      if (rs != rs_)
+      {
+        rs_ = rs;
+        size_cells();
+        return;
+      }
+      std::fill(filled_.begin(), filled_.end(), false);
+    }
 
     bool isNull(std::size_t i) const override
     {
@@ -47,6 +222,25 @@ namespace vix::db
       return rs_->getString(static_cast<unsigned int>(i + 1));
     }
 
+    const ColumnTable &columns() const override
+    {
+      if (!columns_)
+        load_columns();
+      return *columns_;
+    }
+
+    std::string_view getStringView(std::size_t i) const override
+    {
+      const sql::SQLString &s = cell(i);
+      return {s.c_str(), s.length()};
+    }
+
+    std::span<const std::byte> getBlob(std::size_t i) const override
+    {
+      const sql::SQLString &s = cell(i);
+      return {reinterpret_cast<const std::byte *>(s.c_str()), s.length()};
+    }
+
     std::int64_t getInt64(std::size_t i) const override
     {
       return static_cast<std::int64_t>(
@@ -58,16 +252,128 @@ namespace vix::db
       return static_cast<double>(
           rs_->getDouble(static_cast<unsigned int>(i + 1)));
     }
+
+    void decode(std::span<Cell> cells, std::size_t first) const override
+    {
+      // Text and blob cells view cells_, whose strings stay in place
+      // until the next row: decoding later columns keeps them valid.
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        Cell &cell = cells[k];
+        const auto c = static_cast<unsigned int>(first + k + 1);
+        cell.null = rs_->isNull(c);
+        if (cell.null)
+          continue;
+
+        switch (cell.kind)
+        {
+        case Cell::Kind::Int64:
+          cell.i = static_cast<std::int64_t>(rs_->getInt64(c));
+          break;
+        case Cell::Kind::Double:
+          cell.d = static_cast<double>(rs_->getDouble(c));
+          break;
+        case Cell::Kind::Text:
+          cell.text = getStringView(first + k);
+          break;
+        case Cell::Kind::Blob:
+          cell.bytes = getBlob(first + k);
+          break;
+        }
+      }
+    }
+
+    Cell getCell(std::size_t i) const override
+    {
+      const auto c = static_cast<unsigned int>(i + 1);
+      Cell cell;
+      cell.null = rs_->isNull(c);
+      if (cell.null)
+        return cell;
+
+      if (!columns_)
+        load_columns();
+
+      // Same mapping as getValue().
+      switch (types_[i])
+      {
+      case sql::DataType::BIT:
+      case sql::DataType::TINYINT:
+      case sql::DataType::SMALLINT:
+      case sql::DataType::MEDIUMINT:
+      case sql::DataType::INTEGER:
+      case sql::DataType::BIGINT:
+      case sql::DataType::YEAR:
+        cell.kind = Cell::Kind::Int64;
+        cell.i = static_cast<std::int64_t>(rs_->getInt64(c));
+        break;
+      case sql::DataType::REAL:
+      case sql::DataType::DOUBLE:
+        cell.kind = Cell::Kind::Double;
+        cell.d = static_cast<double>(rs_->getDouble(c));
+        break;
+      case sql::DataType::BINARY:
+      case sql::DataType::VARBINARY:
+      case sql::DataType::LONGVARBINARY:
+        cell.kind = Cell::Kind::Blob;
+        cell.bytes = getBlob(i);
+        break;
+      default:
+        cell.kind = Cell::Kind::Text;
+        cell.text = getStringView(i);
+        break;
+      }
+      return cell;
+    }
+
+    DbValue getValue(std::size_t i) const override
+    {
+      const auto c = static_cast<unsigned int>(i + 1);
+      if (rs_->isNull(c))
+        return null();
+
+      if (!columns_)
+        load_columns();
+
+      switch (types_[i])
+      {
+      case sql::DataType::BIT:
+      case sql::DataType::TINYINT:
+      case sql::DataType::SMALLINT:
+      case sql::DataType::MEDIUMINT:
+      case sql::DataType::INTEGER:
+      case sql::DataType::BIGINT:
+      case sql::DataType::YEAR:
+        return i64(static_cast<std::int64_t>(rs_->getInt64(c)));
+      case sql::DataType::REAL:
+      case sql::DataType::DOUBLE:
+        return f64(static_cast<double>(rs_->getDouble(c)));
+      case sql::DataType::BINARY:
+      case sql::DataType::VARBINARY:
+      case sql::DataType::LONGVARBINARY:
+      {
+        const sql::SQLString s = rs_->getString(c);
+        const auto *p = reinterpret_cast<const std::uint8_t *>(s.c_str());
+        return blob(std::vector<std::uint8_t>(p, p + s.length()));
+      }
+      default:
+        // DECIMAL keeps its exact text form, temporal types their ISO text.
+        return str(rs_->getString(c));
+      }
+    }
   };
 
   class MySQLResultSet final : public ResultSet
   {
+    // Declared first: the native result set is closed before the
+    // statement goes back to the cache.
+    std::shared_ptr<MySQLStmtLease> stmt_;
     std::unique_ptr<sql::ResultSet> rs_;
     mutable MySQLResultRow row_{};
 
   public:
-    explicit MySQLResultSet(std::unique_ptr<sql::ResultSet> rs)
-        : rs_(std::move(rs)), row_(rs_.get()) {}
+    MySQLResultSet(std::shared_ptr<MySQLStmtLease> stmt, std::unique_ptr<sql::ResultSet> rs)
+        : stmt_(std::move(stmt)), rs_(std::move(rs)), row_(rs_.get()) {}
 
     bool next() override
     {
@@ -76,10 +382,9 @@ namespace vix::db
       return ok;
     }
 
-    std::size_t cols() const override
-    {
-      return static_cast<std::size_t>(rs_->getMetaData()->getColumnCount());
-    }
+    std::size_t cols() const override { return row_.columns().size(); }
+
+    const ColumnTable &columns() const override { return row_.columns(); }
 
     const ResultRow &row() const override
     {
@@ -87,9 +392,112 @@ namespace vix::db
     }
   };
 
+  // -------------------- Batch rewrite --------------------
+
+  // INSERT/REPLACE ... VALUES (?, ...) split around its row group, so a
+  // batch can run as INSERT ... VALUES (...), (...), ... chunks.
+  struct ValuesSplit
+  {
+    std::string_view head;
+    std::string_view group;
+    std::string_view tail;
+  };
+
+  static std::optional<ValuesSplit> split_values(std::string_view sql)
+  {
+    std::size_t i = 0;
+    while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i])))
+      ++i;
+
+    std::size_t j = detail::word_end(sql, i);
+    const auto verb = sql.substr(i, j - i);
+    if (!detail::iequals(verb, "INSERT") && !detail::iequals(verb, "REPLACE"))
+      return std::nullopt;
+
+    // Find the VALUES keyword outside quotes and comments.
+    std::size_t open = std::string_view::npos;
+    for (i = j; i < sql.size();)
+    {
+      if (const auto next = detail::skip_ignored(sql, i); next != i)
+      {
+        i = next;
+        continue;
+      }
+      if (!detail::is_word_char(sql[i]))
+      {
+        ++i;
+        continue;
+      }
+
+      j = detail::word_end(sql, i);
+      const auto word = sql.substr(i, j - i);
+      i = j;
+
+      if (detail::iequals(word, "VALUES") || detail::iequals(word, "VALUE"))
+      {
+        while (i < sql.size() && std::isspace(static_cast<unsigned char>(sql[i])))
+          ++i;
+        if (i < sql.size() && sql[i] == '(')
+          open = i;
+        break;
+      }
+    }
+    if (open == std::string_view::npos)
+      return std::nullopt;
+
+    // Matching parenthesis of the row group.
+    int depth = 0;
+    for (i = open; i < sql.size();)
+    {
+      if (const auto next = detail::skip_ignored(sql, i); next != i)
+      {
+        i = next;
+        continue;
+      }
+      const char c = sql[i];
+      if (c == '(')
+        ++depth;
+      else if (c == ')' && --depth == 0)
+        break;
+      ++i;
+    }
+    if (i >= sql.size())
+      return std::nullopt;
+
+    ValuesSplit out{sql.substr(0, open), sql.substr(open, i + 1 - open), sql.substr(i + 1)};
+
+    // Only the row group may hold placeholders, and it must be the only
+    // row: literal rows after it would be inserted once per chunk.
+    if (count_placeholders(out.head) != 0 || count_placeholders(out.tail) != 0)
+      return std::nullopt;
+    const auto next = out.tail.find_first_not_of(" \t\r\n");
+    if (next != std::string_view::npos && out.tail[next] == ',')
+      return std::nullopt;
+    return out;
+  }
+
+  static std::string multi_row_sql(const ValuesSplit &v, std::size_t rows)
+  {
+    std::string out;
+    out.reserve(v.head.size() + rows * (v.group.size() + 2) + v.tail.size());
+    out.append(v.head);
+    for (std::size_t r = 0; r < rows; ++r)
+    {
+      if (r)
+        out.append(", ");
+      out.append(v.group);
+    }
+    out.append(v.tail);
+    return out;
+  }
+
+  // -------------------- Statement --------------------
+
   class MySQLStatement final : public Statement
   {
-    std::unique_ptr<sql::PreparedStatement> ps_;
+    MySQLConnection *conn_ = nullptr;
+    std::shared_ptr<MySQLStmtLease> stmt_;
+    sql::PreparedStatement *ps_ = nullptr;
 
     static unsigned int ui(std::size_t i)
     {
@@ -97,100 +505,369 @@ namespace vix::db
       return static_cast<unsigned int>(i);
     }
 
-    static void bind_null(sql::PreparedStatement &ps, unsigned int i)
+    // Below this size a copy is cheaper than streaming the parameter.
+    static constexpr std::size_t kStreamThreshold = 4096;
+
+    // Streams bound to blob parameters, alive until rebound. Text is
+    // never streamed: setBlob() sends it typed as a blob, without the
+    // connection's character set and collation.
+    std::vector<std::unique_ptr<ViewStream>> views_;
+
+    // Copies of blobs bound by bindBlobCopy(), streamed like views. Only
+    // copies above kStreamThreshold are streamed, and their heap buffers
+    // stay put when the vector grows.
+    std::vector<std::string> copies_;
+
+    // Non-zero: query() streams its result, see setFetchSize().
+    std::size_t fetch_size_ = 0;
+
+    void bind_blob_view(std::size_t idx, const char *p, std::size_t n)
+    {
+      const auto i = ui(idx);
+      try
+      {
+        if (n < kStreamThreshold)
+        {
+          ps_->setString(i, sql::SQLString(p ? p : "", n));
+          return;
+        }
+
+        if (views_.size() <= idx)
+          views_.resize(idx + 1);
+        views_[idx] = std::make_unique<ViewStream>(p, n);
+        ps_->setBlob(i, views_[idx].get());
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL bind failed");
+      }
+    }
+
+    void rewind_views()
     {
-      ps.setNull(i, 0);
+      for (auto &v : views_)
+      {
+        if (v)
+          v->rewind();
+      }
     }
 
   public:
-    explicit MySQLStatement(std::unique_ptr<sql::PreparedStatement> ps)
-        : ps_(std::move(ps)) {}
+    MySQLStatement(MySQLConnection *conn, std::shared_ptr<MySQLStmtLease> stmt)
+        : conn_(conn), stmt_(std::move(stmt)), ps_(&stmt_->get()) {}
 
-    void bind(std::size_t idx, const DbValue &v) override
+    void bindNull(std::size_t idx) override
     {
-      const auto i = ui(idx);
+      try
+      {
+        ps_->setNull(ui(idx), 0);
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL bind failed");
+      }
+    }
 
+    void bindInt64(std::size_t idx, std::int64_t v) override
+    {
       try
       {
-        std::visit(
-            [&](const auto &x)
-            {
-              using T = std::decay_t<decltype(x)>;
-
-              if constexpr (std::is_same_v<T, std::nullptr_t>)
-              {
-                bind_null(*ps_, i);
-              }
-              else if constexpr (std::is_same_v<T, bool>)
-              {
-                ps_->setBoolean(i, x);
-              }
-              else if constexpr (std::is_same_v<T, std::int64_t>)
-              {
-                ps_->setInt64(i, x);
-              }
-              else if constexpr (std::is_same_v<T, double>)
-              {
-                ps_->setDouble(i, x);
-              }
-              else if constexpr (std::is_same_v<T, std::string>)
-              {
-                ps_->setString(i, x);
-              }
-              else if constexpr (std::is_same_v<T, Blob>)
-              {
-                throw DBError("MySQL bind Blob not implemented yet");
-              }
-              else
-              {
-                throw DBError("Unsupported DbValue variant in MySQLStatement::bind");
-              }
-            },
-            v);
+        ps_->setInt64(ui(idx), v);
       }
       catch (const sql::SQLException &e)
       {
-        throw DBError(std::string{"MySQL bind failed: "} + e.what());
+        throw_mysql(e, "MySQL bind failed");
       }
     }
 
-    std::unique_ptr<ResultSet> query() override
+    void bindDouble(std::size_t idx, double v) override
     {
       try
       {
-        auto rs = std::unique_ptr<sql::ResultSet>(ps_->executeQuery());
-        return std::make_unique<MySQLResultSet>(std::move(rs));
+        ps_->setDouble(ui(idx), v);
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL bind failed");
+      }
+    }
+
+    void bindText(std::size_t idx, std::string_view v) override
+    {
+      bindTextCopy(idx, v);
+    }
+
+    void bindBlob(std::size_t idx, std::span<const std::byte> v) override
+    {
+      bind_blob_view(idx, reinterpret_cast<const char *>(v.data()), v.size());
+    }
+
+    void bindTextCopy(std::size_t idx, std::string_view v) override
+    {
+      try
+      {
+        ps_->setString(ui(idx), sql::SQLString(v.data() ? v.data() : "", v.size()));
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL bind failed");
+      }
+    }
+
+    void bindBlobCopy(std::size_t idx, std::span<const std::byte> v) override
+    {
+      if (copies_.size() <= idx)
+        copies_.resize(idx + 1);
+      copies_[idx].assign(reinterpret_cast<const char *>(v.data()), v.size());
+      bind_blob_view(idx, copies_[idx].data(), copies_[idx].size());
+    }
+
+    // Connector/C++ has no MYSQL_TIME setter: setDateTime() sends the
+    // text typed as DATETIME, which the server stores natively.
+    void bindTimestamp(std::size_t idx, Timestamp v) override
+    {
+      try
+      {
+        ps_->setDateTime(ui(idx), to_string(v));
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL bind failed");
+      }
+    }
+
+    void bindDate(std::size_t idx, Date v) override
+    {
+      try
+      {
+        ps_->setDateTime(ui(idx), to_string(v));
       }
       catch (const sql::SQLException &e)
       {
-        throw DBError(std::string{"MySQL query failed: "} + e.what());
+        throw_mysql(e, "MySQL bind failed");
       }
     }
 
-    std::uint64_t exec() override
+    std::unique_ptr<ResultSet> query() override { return tryQuery().value(); }
+
+    // Connector/C++ itself reports failures by exception; they are
+    // caught here and returned, without a second throw.
+    Expected<std::unique_ptr<ResultSet>> tryQuery() override
+    {
+      rewind_views();
+      try
+      {
+        auto rs = fetch_size_ ? executeStreaming()
+                              : std::unique_ptr<sql::ResultSet>(ps_->executeQuery());
+        return std::unique_ptr<ResultSet>(std::make_unique<MySQLResultSet>(stmt_, std::move(rs)));
+      }
+      catch (const sql::SQLException &e)
+      {
+        return expected_failure(e, "MySQL query failed");
+      }
+    }
+
+    // Connector/C++ reads a forward-only result unbuffered, pulling one
+    // row from the socket per next(): any non-zero fetch size streams,
+    // holding a single row client-side.
+    void setFetchSize(std::size_t rows) override { fetch_size_ = rows; }
+
+    std::uint64_t exec() override { return tryExec().value(); }
+
+    Expected<std::uint64_t> tryExec() override
     {
+      rewind_views();
       try
       {
         return static_cast<std::uint64_t>(ps_->executeUpdate());
       }
       catch (const sql::SQLException &e)
       {
-        throw DBError(std::string{"MySQL exec failed: "} + e.what());
+        return expected_failure(e, "MySQL exec failed");
       }
     }
+
+    std::vector<std::uint64_t> execBatch(const ParamBatch &batch) override
+    {
+      std::vector<std::uint64_t> counts;
+      if (batch.empty())
+        return counts;
+
+      auto &native = *conn_->raw();
+      bool own_tx = false;
+      try
+      {
+        // Outside a transaction, run the batch in one.
+        own_tx = native.getAutoCommit();
+        if (own_tx)
+          native.setAutoCommit(false);
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL batch failed");
+      }
+
+      try
+      {
+        const auto split = batch.width() ? split_values(stmt_->sql()) : std::nullopt;
+        if (split)
+          counts = execMultiRow(*split, batch);
+        else
+          counts = Statement::execBatch(batch);
+
+        if (own_tx)
+        {
+          native.commit();
+          native.setAutoCommit(true);
+        }
+      }
+      catch (const sql::SQLException &e)
+      {
+        if (own_tx)
+          restore_autocommit(native);
+        throw_mysql(e, "MySQL batch commit failed");
+      }
+      catch (...)
+      {
+        if (own_tx)
+          restore_autocommit(native);
+        throw;
+      }
+      return counts;
+    }
+
+  private:
+    // Classified failures are returned, the rest thrown.
+    static ErrorInfo expected_failure(const sql::SQLException &e, const char *prefix)
+    {
+      ErrorInfo info = mysql_error(e, prefix);
+      if (info.code == DbErrorCode::Other)
+        raise(info);
+      return info;
+    }
+
+    // Run the query with an unbuffered, forward-only result. The
+    // handle's own result type, buffered by default, is restored before
+    // it can go back to the statement cache.
+    std::unique_ptr<sql::ResultSet> executeStreaming()
+    {
+      const auto type = ps_->getResultSetType();
+      ps_->setResultSetType(sql::ResultSet::TYPE_FORWARD_ONLY);
+      try
+      {
+        auto rs = std::unique_ptr<sql::ResultSet>(ps_->executeQuery());
+        ps_->setResultSetType(type);
+        return rs;
+      }
+      catch (...)
+      {
+        ps_->setResultSetType(type);
+        throw;
+      }
+    }
+
+    // Chunks stay within the connection's InsertLimits (placeholders and
+    // max_allowed_packet), and under a fixed row count.
+    static constexpr std::size_t kMaxBatchRows = 1000;
+
+    static void restore_autocommit(sql::Connection &native) noexcept
+    {
+      try
+      {
+        native.rollback();
+        native.setAutoCommit(true);
+      }
+      catch (...)
+      {
+      }
+    }
+
+    std::vector<std::uint64_t> execMultiRow(const ValuesSplit &split, const ParamBatch &batch)
+    {
+      const std::size_t width = batch.width();
+      const InsertLimits limits = conn_->insertLimits();
+      const std::size_t per_chunk = std::max<std::size_t>(
+          1, std::min(kMaxBatchRows, limits.max_params / width));
+
+      // SQL text around the groups, and per row: the group, ", " and a
+      // type tag per value, as in Connection::insertMany().
+      const std::size_t header = split.head.size() + split.tail.size();
+      const std::size_t row_overhead = split.group.size() + 2 + 2 * width;
+
+      std::vector<std::uint64_t> counts;
+      counts.reserve((batch.size() + per_chunk - 1) / per_chunk);
+
+      // Full chunks share one statement; shorter ones, rounded down to a
+      // power of two to bound the number of shapes, are prepared through
+      // the connection's statement cache.
+      std::unique_ptr<Statement> full;
+      for (std::size_t first = 0; first < batch.size();)
+      {
+        std::size_t rows = std::min(per_chunk, batch.size() - first);
+
+        if (limits.max_bytes != 0)
+        {
+          std::size_t bytes = header;
+          std::size_t fit = 0;
+          for (; fit < rows; ++fit)
+          {
+            std::size_t row_bytes = row_overhead;
+            for (const auto &v : batch.row(first + fit))
+              row_bytes += bound_size(v);
+
+            // a single oversized row is still sent, the server reports it
+            if (fit > 0 && bytes + row_bytes > limits.max_bytes)
+              break;
+            bytes += row_bytes;
+          }
+          rows = fit;
+        }
+
+        std::unique_ptr<Statement> partial;
+        Statement *st = nullptr;
+        if (rows == per_chunk)
+        {
+          if (!full)
+            full = conn_->prepare(multi_row_sql(split, rows));
+          st = full.get();
+        }
+        else
+        {
+          rows = std::bit_floor(rows);
+          partial = conn_->prepare(multi_row_sql(split, rows));
+          st = partial.get();
+        }
+
+        const auto values = batch.rows(first, rows);
+        for (std::size_t i = 0; i < values.size(); ++i)
+          st->bind(i + 1, values[i]);
+        counts.push_back(st->exec());
+        first += rows;
+      }
+      return counts;
+    }
   };
 
   std::unique_ptr<Statement> MySQLConnection::prepare(std::string_view sql)
   {
+    if (cache_.enabled())
+    {
+      if (auto hit = cache_.take(sql))
+        return std::make_unique<MySQLStatement>(
+            this, std::make_shared<MySQLStmtLease>(&cache_, std::move(*hit)));
+    }
+
     try
     {
-      auto ps = std::unique_ptr<sql::PreparedStatement>(
-          conn_->prepareStatement(std::string(sql)));
-      return std::make_unique<MySQLStatement>(std::move(ps));
+      std::string text(sql);
+      auto ps = std::unique_ptr<sql::PreparedStatement>(conn_->prepareStatement(text));
+      MySQLStatementCache::Entry entry{std::move(text), std::move(ps)};
+      return std::make_unique<MySQLStatement>(
+          this, std::make_shared<MySQLStmtLease>(cache_.enabled() ? &cache_ : nullptr, std::move(entry)));
     }
     catch (const sql::SQLException &e)
     {
-      throw DBError(std::string{"MySQL prepare failed: "} + e.what());
+      throw_mysql(e, "MySQL prepare failed");
     }
   }
 
@@ -207,10 +884,35 @@ namespace vix::db
     }
     catch (const sql::SQLException &e)
     {
-      throw DBError(std::string{"MySQL lastInsertId failed: "} + e.what());
+      throw_mysql(e, "MySQL lastInsertId failed");
     }
   }
 
+  InsertLimits MySQLConnection::insertLimits()
+  {
+    if (max_packet_ == 0)
+    {
+      try
+      {
+        auto st = std::unique_ptr<sql::Statement>(conn_->createStatement());
+        auto rs = std::unique_ptr<sql::ResultSet>(
+            st->executeQuery("SELECT @@max_allowed_packet AS packet"));
+        if (!rs->next())
+          throw DBError("No @@max_allowed_packet");
+        max_packet_ = static_cast<std::size_t>(rs->getUInt64("packet"));
+      }
+      catch (const sql::SQLException &e)
+      {
+        throw_mysql(e, "MySQL insertLimits failed");
+      }
+    }
+
+    InsertLimits limits;
+    limits.max_params = 65535;
+    limits.max_bytes = max_packet_;
+    return limits;
+  }
+
   std::shared_ptr<sql::Connection> make_mysql_conn(
       const std::string &host,
       const std::string &user,
@@ -227,7 +929,7 @@ namespace vix::db
     }
     catch (const sql::SQLException &e)
     {
-      throw DBError(std::string{"MySQL connect failed: "} + e.what());
+      throw_mysql(e, "MySQL connect failed");
     }
   }
 
@@ -236,15 +938,17 @@ namespace vix::db
       std::string host,
       std::string user,
       std::string pass,
-      std::string db)
+      std::string db,
+      std::size_t statement_cache)
   {
     return [host = std::move(host),
             user = std::move(user),
             pass = std::move(pass),
-            db = std::move(db)]() -> std::shared_ptr<Connection>
+            db = std::move(db),
+            statement_cache]() -> std::shared_ptr<Connection>
     {
       auto raw = make_mysql_conn(host, user, pass, db);
-      auto mysql_conn = std::make_shared<MySQLConnection>(std::move(raw));
+      auto mysql_conn = std::make_shared<MySQLConnection>(std::move(raw), statement_cache);
       return std::static_pointer_cast<Connection>(mysql_conn);
     };
   }
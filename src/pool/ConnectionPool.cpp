@@ -13,73 +13,679 @@
 #include <vix/db/pool/ConnectionPool.hpp>
 #include <vix/db/core/Errors.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <exception>
+#include <system_error>
+#include <vector>
+
 namespace vix::db
 {
-  ConnectionPtr ConnectionPool::acquire()
+  namespace
   {
-    std::unique_lock lk(m_);
+    using Clock = ConnectionPool::Clock;
+
+    // Upper bound on concurrent connects during warmup().
+    constexpr std::size_t kMaxWarmupThreads = 16;
+
+    // Stable small integer per thread, used to pick a local slot.
+    std::size_t thread_ordinal() noexcept
+    {
+      static std::atomic<std::size_t> next{0};
+      thread_local const std::size_t ordinal =
+          next.fetch_add(1, std::memory_order_relaxed);
+      return ordinal;
+    }
+
+    std::size_t slot_count_for(const PoolConfig &cfg)
+    {
+      if (!cfg.local_cache)
+        return 0;
+
+      const std::size_t hw =
+          std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+      return std::bit_ceil(hw * 2);
+    }
+
+    Clock::time_point deadline_after(Clock::duration d)
+    {
+      const auto now = Clock::now();
+      if (d > Clock::time_point::max() - now)
+        return Clock::time_point::max();
+      return now + std::max(d, Clock::duration::zero());
+    }
+
+    bool maintenance_enabled(const PoolConfig &cfg)
+    {
+      return cfg.idle_timeout.count() > 0 ||
+             cfg.max_lifetime.count() > 0 ||
+             cfg.validation_interval.count() > 0;
+    }
+
+    // Wake up often enough to honour the shortest configured interval,
+    // and at least once per second.
+    Clock::duration maintenance_period(const PoolConfig &cfg)
+    {
+      using std::chrono::milliseconds;
+
+      milliseconds period{1000};
+      for (milliseconds d : {cfg.idle_timeout, cfg.max_lifetime, cfg.validation_interval})
+      {
+        if (d.count() > 0)
+          period = std::min(period, std::max(d / 2, milliseconds{10}));
+      }
+      return period;
+    }
+  } // namespace
+
+  ConnectionPool::ConnectionPool(ConnectionFactory factory, PoolConfig cfg)
+      : factory_(std::move(factory)), cfg_(cfg), rng_(std::random_device{}())
+  {
+    const std::size_t n = slot_count_for(cfg_);
+    if (n > 0)
+    {
+      slots_ = std::make_unique<LocalSlot[]>(n);
+      slot_mask_ = n - 1;
+    }
+
+    if (maintenance_enabled(cfg_))
+    {
+      maintainer_ = std::thread([this, period = maintenance_period(cfg_)]
+                                { maintenanceLoop(period); });
+    }
+  }
+
+  ConnectionPool::~ConnectionPool()
+  {
+    {
+      std::lock_guard lk(m_);
+      stop_ = true;
+    }
+    maint_cv_.notify_all();
+
+    if (maintainer_.joinable())
+      maintainer_.join();
+  }
+
+  ConnectionPool::LocalSlot *ConnectionPool::localSlot() noexcept
+  {
+    if (!slots_)
+      return nullptr;
+    return &slots_[thread_ordinal() & slot_mask_];
+  }
+
+  ConnectionPool::Idle ConnectionPool::takeLocal(LocalSlot &slot, bool wait) noexcept
+  {
+    // With wait, a busy slot is retried until it is seen empty: the
+    // holder is mid-move and releases it right away.
+    for (;;)
+    {
+      if (!slot.occupied.load())
+        return {};
+      if (!slot.busy.exchange(true))
+        break;
+      if (!wait)
+        return {};
+      std::this_thread::yield();
+    }
+
+    auto e = std::move(slot.entry);
+    slot.entry.conn.reset();
+    slot.occupied.store(false);
+    slot.busy.store(false);
+    return e;
+  }
+
+  bool ConnectionPool::putLocal(LocalSlot &slot, ConnectionPtr &c) noexcept
+  {
+    if (slot.busy.exchange(true))
+      return false;
+
+    if (slot.entry.conn)
+    {
+      slot.busy.store(false);
+      return false;
+    }
+
+    slot.entry.conn = std::move(c);
+    slot.entry.since = Clock::now();
+    slot.occupied.store(true);
+    slot.busy.store(false);
+    return true;
+  }
+
+  ConnectionPool::Idle ConnectionPool::stealLocal(bool wait) noexcept
+  {
+    if (!slots_)
+      return {};
+
+    for (std::size_t i = 0; i <= slot_mask_; ++i)
+    {
+      if (auto e = takeLocal(slots_[i], wait); e.conn)
+        return e;
+    }
+    return {};
+  }
 
-    while (!idle_.empty())
+  void ConnectionPool::enqueue(Waiter &w) noexcept
+  {
+    w.prev = tail_;
+    if (tail_)
+      tail_->next = &w;
+    else
+      head_ = &w;
+    tail_ = &w;
+    waiters_.fetch_add(1);
+  }
+
+  void ConnectionPool::unlink(Waiter &w) noexcept
+  {
+    if (w.prev)
+      w.prev->next = w.next;
+    else
+      head_ = w.next;
+
+    if (w.next)
+      w.next->prev = w.prev;
+    else
+      tail_ = w.prev;
+
+    w.prev = w.next = nullptr;
+    waiters_.fetch_sub(1);
+  }
+
+  // Requires m_. The waiter node lives on the waiter's stack, so it is
+  // notified while the lock is still held.
+  void ConnectionPool::handOff(Idle e)
+  {
+    if (Waiter *w = head_)
     {
-      auto c = idle_.front();
-      idle_.pop();
+      unlink(*w);
+      w->entry = std::move(e);
+      w->granted = true;
+      w->cv.notify_one();
+      return;
+    }
+
+    idle_.push_back(std::move(e));
+  }
 
-      if (!c || !c->ping())
+  // Requires m_.
+  void ConnectionPool::track(const Connection *c)
+  {
+    const auto now = Clock::now();
+    Lifetime lt{Clock::time_point::max(), now};
+
+    if (cfg_.max_lifetime.count() > 0)
+    {
+      auto life = cfg_.max_lifetime;
+      if (cfg_.lifetime_jitter.count() > 0)
       {
-        if (total_ > 0)
-          --total_;
-        continue;
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+            0, std::min(cfg_.lifetime_jitter, life).count());
+        life -= std::chrono::milliseconds(jitter(rng_));
       }
+      lt.expires = now + life;
+    }
+
+    lifetimes_.insert_or_assign(c, lt);
+  }
+
+  // Requires m_.
+  void ConnectionPool::forget(const Connection *c)
+  {
+    if (total_ > 0)
+      --total_;
 
-      return c;
+    if (c)
+    {
+      lifetimes_.erase(c);
+      destroyed_.fetch_add(1, std::memory_order_relaxed);
     }
+  }
 
-    if (total_ < cfg_.max)
+  void ConnectionPool::discard(const Connection *c)
+  {
+    std::lock_guard lk(m_);
+    forget(c);
+
+    // The freed capacity goes to the oldest waiter as a permit to create.
+    if (Waiter *w = head_)
     {
+      unlink(*w);
       ++total_;
-      lk.unlock();
+      w->granted = true;
+      w->cv.notify_one();
+    }
+  }
+
+  // Only connections idle past validate_after cost a round trip. With
+  // background validation the request path trusts idle connections.
+  bool ConnectionPool::usable(const Idle &e) const
+  {
+    if (!e.conn)
+      return false;
 
-      auto c = factory_();
-      if (!c || !c->ping())
+    if (cfg_.validation_interval.count() > 0)
+      return true;
+
+    if (cfg_.validate_after.count() > 0 &&
+        Clock::now() - e.since < cfg_.validate_after)
+      return true;
+
+    return e.conn->ping();
+  }
+
+  ConnectionPtr ConnectionPool::create()
+  {
+    const auto started = Clock::now();
+
+    ConnectionPtr c;
+    try
+    {
+      c = factory_();
+    }
+    catch (...)
+    {
+      discard(nullptr);
+      throw;
+    }
+
+    if (!c || !c->ping())
+    {
+      discard(nullptr);
+      throw DBError("ConnectionPool: factory returned invalid connection");
+    }
+
+    connect_time_.record(Clock::now() - started);
+    created_.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard lk(m_);
+    track(c.get());
+    return c;
+  }
+
+  ConnectionPtr ConnectionPool::acquire()
+  {
+    if (cfg_.acquire_timeout.count() > 0)
+      return acquire(deadline_after(cfg_.acquire_timeout));
+    return acquire(Clock::time_point::max());
+  }
+
+  ConnectionPtr ConnectionPool::acquire(Clock::time_point deadline)
+  {
+    auto c = acquireUntil(deadline);
+    if (!c)
+      throw PoolTimeout("ConnectionPool: timed out waiting for a connection");
+    return c;
+  }
+
+  ConnectionPtr ConnectionPool::tryAcquireFor(Clock::duration timeout)
+  {
+    return acquireUntil(deadline_after(timeout));
+  }
+
+  ConnectionPtr ConnectionPool::acquireUntil(Clock::time_point deadline)
+  {
+    if (auto *slot = localSlot())
+    {
+      if (auto e = takeLocal(*slot); e.conn)
       {
-        std::lock_guard g(m_);
-        if (total_ > 0)
-          --total_;
-        throw DBError("ConnectionPool: factory returned invalid connection");
+        if (usable(e))
+        {
+          slot->hits.fetch_add(1, std::memory_order_relaxed);
+          return std::move(e.conn);
+        }
+        discard(e.conn.get());
       }
-      return c;
     }
 
-    cv_.wait(lk, [&]
-             { return !idle_.empty(); });
+    const auto started = Clock::now();
+    auto c = acquireShared(deadline);
 
-    // on réessaye via le while
+    if (c)
+      acquire_wait_.record(Clock::now() - started);
+    else
+      timeouts_.fetch_add(1, std::memory_order_relaxed);
+    return c;
+  }
+
+  ConnectionPtr ConnectionPool::acquireShared(Clock::time_point deadline)
+  {
+    std::unique_lock lk(m_);
+
+    // Nobody may bypass callers that are already queued.
+    if (!head_)
+    {
+      // Most recently used first, so surplus connections age out.
+      while (!idle_.empty())
+      {
+        auto e = std::move(idle_.back());
+        idle_.pop_back();
+
+        if (!usable(e))
+        {
+          forget(e.conn.get());
+          continue;
+        }
+
+        return std::move(e.conn);
+      }
+
+      // Connections parked in other threads' slots are reused before growing.
+      for (auto e = stealLocal(); e.conn; e = stealLocal())
+      {
+        if (usable(e))
+          return std::move(e.conn);
+        forget(e.conn.get());
+      }
+
+      if (total_ < cfg_.max)
+      {
+        ++total_;
+        lk.unlock();
+        return create();
+      }
+    }
+
+    Waiter w;
+    enqueue(w);
+
+    // Announce ourselves before the last slot scan: a releaser either
+    // sees the waiter and hands off, or we find its connection here.
+    // The scan waits out busy slots so a parked connection is not missed.
+    if (auto e = stealLocal(true); e.conn)
+      handOff(std::move(e));
+
+    while (!w.granted)
+    {
+      if (deadline == Clock::time_point::max())
+      {
+        w.cv.wait(lk);
+      }
+      else if (w.cv.wait_until(lk, deadline) == std::cv_status::timeout &&
+               !w.granted)
+      {
+        unlink(w);
+        return {};
+      }
+    }
+
+    // Either a released connection or a permit to create one. A handed
+    // over connection that turns out dead is replaced in place: its
+    // capacity already belongs to this caller.
+    if (usable(w.entry))
+      return std::move(w.entry.conn);
+
+    if (w.entry.conn)
+    {
+      lifetimes_.erase(w.entry.conn.get());
+      destroyed_.fetch_add(1, std::memory_order_relaxed);
+    }
     lk.unlock();
-    return acquire();
+
+    w.entry.conn.reset();
+    return create();
   }
 
   void ConnectionPool::release(ConnectionPtr c)
   {
+    if (!c)
+      return;
+
+    if (auto *slot = localSlot(); slot && waiters_.load() == 0)
+    {
+      if (putLocal(*slot, c))
+      {
+        if (waiters_.load() == 0)
+          return;
+
+        // A waiter showed up meanwhile: hand the connection over.
+        // The slot is only given up once seen empty, i.e. another
+        // thread really took the connection.
+        c = std::move(takeLocal(*slot, true).conn);
+        if (!c)
+          return;
+      }
+    }
+
+    std::lock_guard lk(m_);
+    handOff(Idle{std::move(c), Clock::now()});
+  }
+
+  void ConnectionPool::invalidate(ConnectionPtr c)
+  {
+    if (c)
+      discard(c.get());
+  }
+
+  void ConnectionPool::warmup(const std::function<void()> &on_first)
+  {
+    // Reserve the missing capacity up front so concurrent acquire() calls
+    // queue for these connections instead of opening their own.
+    std::size_t missing = 0;
     {
       std::lock_guard lk(m_);
-      if (c)
-        idle_.push(std::move(c));
+      const std::size_t target = std::min(cfg_.min, cfg_.max);
+      if (total_ < target)
+      {
+        missing = target - total_;
+        total_ += missing;
+      }
+    }
+
+    if (missing == 0)
+    {
+      if (on_first)
+        on_first();
+      return;
     }
-    cv_.notify_one();
+
+    std::atomic<std::size_t> next{0};
+    std::once_flag first;
+    std::mutex error_m;
+    std::exception_ptr error;
+
+    auto work = [&]
+    {
+      while (next.fetch_add(1) < missing)
+      {
+        try
+        {
+          auto c = create();
+          {
+            std::lock_guard lk(m_);
+            handOff(Idle{std::move(c), Clock::now()});
+          }
+          if (on_first)
+            std::call_once(first, on_first);
+        }
+        catch (...)
+        {
+          std::lock_guard g(error_m);
+          if (!error)
+            error = std::current_exception();
+        }
+      }
+    };
+
+    std::vector<std::thread> helpers;
+    const std::size_t workers = std::min(missing, kMaxWarmupThreads);
+    for (std::size_t i = 1; i < workers; ++i)
+    {
+      try
+      {
+        helpers.emplace_back(work);
+      }
+      catch (const std::system_error &)
+      {
+        // The calling thread picks up whatever is left.
+        break;
+      }
+    }
+
+    work();
+    for (auto &t : helpers)
+      t.join();
+
+    if (error)
+      std::rethrow_exception(error);
   }
 
-  void ConnectionPool::warmup()
+  void ConnectionPool::maintain()
   {
-    std::lock_guard lk(m_);
+    const auto now = Clock::now();
+    const auto older_first = [](const Idle &a, const Idle &b)
+    { return a.since < b.since; };
+
+    std::vector<Idle> evict;
+    std::vector<Idle> check;
 
-    for (std::size_t i = 0; i < cfg_.min; ++i)
     {
-      auto c = factory_();
-      if (!c || !c->ping())
-        throw DBError("ConnectionPool::warmup: factory returned invalid connection");
+      std::lock_guard lk(m_);
 
-      idle_.push(std::move(c));
-      ++total_;
+      // Connections parked in local slots age like the shared stock.
+      for (auto e = stealLocal(); e.conn; e = stealLocal())
+        idle_.push_back(std::move(e));
+      std::stable_sort(idle_.begin(), idle_.end(), older_first);
+
+      std::size_t live = total_;
+      std::deque<Idle> keep;
+
+      for (auto &e : idle_)
+      {
+        const auto it = lifetimes_.find(e.conn.get());
+        const bool expired = it != lifetimes_.end() && now >= it->second.expires;
+        const bool stale = cfg_.idle_timeout.count() > 0 &&
+                           now - e.since >= cfg_.idle_timeout &&
+                           live > cfg_.min;
+
+        if (expired || stale)
+        {
+          evict.push_back(std::move(e));
+          --live;
+        }
+        else if (cfg_.validation_interval.count() > 0 &&
+                 it != lifetimes_.end() &&
+                 now - it->second.checked >= cfg_.validation_interval)
+        {
+          check.push_back(std::move(e));
+        }
+        else
+        {
+          keep.push_back(std::move(e));
+        }
+      }
+
+      idle_.swap(keep);
+    }
+
+    // Pings run without the lock: the connections are out of the pool.
+    std::vector<Idle> alive;
+    for (auto &e : check)
+    {
+      if (e.conn->ping())
+        alive.push_back(std::move(e));
+      else
+        evict.push_back(std::move(e));
+    }
+
+    if (!alive.empty())
+    {
+      std::lock_guard lk(m_);
+      for (auto &e : alive)
+      {
+        if (auto it = lifetimes_.find(e.conn.get()); it != lifetimes_.end())
+          it->second.checked = now;
+
+        if (head_)
+          handOff(std::move(e));
+        else
+          idle_.push_back(std::move(e));
+      }
+      std::stable_sort(idle_.begin(), idle_.end(), older_first);
+    }
+
+    for (auto &e : evict)
+      discard(e.conn.get());
+    evict.clear();
+
+    // Refill up to min so the next burst does not pay for reconnects.
+    for (;;)
+    {
+      {
+        std::lock_guard lk(m_);
+        if (stop_ || total_ >= cfg_.min || total_ >= cfg_.max)
+          break;
+        ++total_;
+      }
+
+      ConnectionPtr c;
+      try
+      {
+        c = create();
+      }
+      catch (...)
+      {
+        // create() gave the capacity back; retry on the next pass.
+        break;
+      }
+
+      std::lock_guard lk(m_);
+      handOff(Idle{std::move(c), Clock::now()});
+    }
+  }
+
+  PoolStats ConnectionPool::stats() const
+  {
+    PoolStats s;
+    std::uint64_t hits = 0;
+    std::size_t parked = 0;
+    std::size_t total = 0;
+
+    {
+      std::lock_guard lk(m_);
+      for (std::size_t i = 0; slots_ && i <= slot_mask_; ++i)
+      {
+        auto &slot = slots_[i];
+        hits += slot.hits.load(std::memory_order_relaxed);
+
+        // Read without taking the slot, which would make a concurrent
+        // hand-over to a waiter miss the connection.
+        if (slot.occupied.load(std::memory_order_relaxed))
+          ++parked;
+      }
+      s.idle = idle_.size() + parked;
+      total = total_;
+    }
+
+    s.in_use = total > s.idle ? total - s.idle : 0;
+    s.waiters = waiters_.load(std::memory_order_relaxed);
+    s.max = cfg_.max;
+    s.created = created_.load(std::memory_order_relaxed);
+    s.destroyed = destroyed_.load(std::memory_order_relaxed);
+    s.timeouts = timeouts_.load(std::memory_order_relaxed);
+    s.acquire_wait = acquire_wait_.snapshot();
+    s.acquire_wait.buckets[0] += hits;
+    s.connect_time = connect_time_.snapshot();
+    return s;
+  }
+
+  void ConnectionPool::maintenanceLoop(Clock::duration period)
+  {
+    std::unique_lock lk(m_);
+    while (!maint_cv_.wait_for(lk, period, [&]
+                               { return stop_; }))
+    {
+      lk.unlock();
+      try
+      {
+        maintain();
+      }
+      catch (...)
+      {
+      }
+      lk.lock();
     }
   }
 
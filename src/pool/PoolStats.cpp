@@ -0,0 +1,131 @@
+/**
+ *
+ *  @file PoolStats.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/pool/PoolStats.hpp>
+
+#include <sstream>
+
+namespace vix::db
+{
+  namespace
+  {
+    using Pools = std::vector<std::pair<std::string, PoolStats>>;
+
+    std::string label_value(const std::string &v)
+    {
+      std::string out;
+      out.reserve(v.size());
+      for (char c : v)
+      {
+        if (c == '\\' || c == '"')
+        {
+          out += '\\';
+          out += c;
+        }
+        else if (c == '\n')
+        {
+          out += "\\n";
+        }
+        else
+        {
+          out += c;
+        }
+      }
+      return out;
+    }
+
+    void header(std::ostringstream &os, const char *name, const char *type, const char *help)
+    {
+      os << "# HELP " << name << ' ' << help << '\n';
+      os << "# TYPE " << name << ' ' << type << '\n';
+    }
+
+    template <typename Get>
+    void family(std::ostringstream &os, const Pools &pools,
+                const char *name, const char *type, const char *help, Get get)
+    {
+      header(os, name, type, help);
+      for (const auto &[pool, s] : pools)
+        os << name << "{pool=\"" << label_value(pool) << "\"} " << get(s) << '\n';
+    }
+
+    template <typename Get>
+    void histogram(std::ostringstream &os, const Pools &pools,
+                   const char *name, const char *help, Get get)
+    {
+      header(os, name, "histogram", help);
+      for (const auto &[pool, s] : pools)
+      {
+        const HistogramSnapshot &h = get(s);
+        const std::string label = "pool=\"" + label_value(pool) + "\"";
+
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i + 1 < kHistogramBuckets; ++i)
+        {
+          cumulative += h.buckets[i];
+          os << name << "_bucket{" << label << ",le=\""
+             << HistogramSnapshot::upperBoundSeconds(i) << "\"} " << cumulative << '\n';
+        }
+        os << name << "_bucket{" << label << ",le=\"+Inf\"} " << h.count() << '\n';
+        os << name << "_sum{" << label << "} " << static_cast<double>(h.sum_ns) / 1e9 << '\n';
+        os << name << "_count{" << label << "} " << h.count() << '\n';
+      }
+    }
+  } // namespace
+
+  std::string render_prometheus(const Pools &pools)
+  {
+    std::ostringstream os;
+    os.precision(9);
+
+    header(os, "vix_db_pool_connections", "gauge", "Pooled connections by state.");
+    for (const auto &[pool, s] : pools)
+    {
+      const std::string p = label_value(pool);
+      os << "vix_db_pool_connections{pool=\"" << p << "\",state=\"in_use\"} " << s.in_use << '\n';
+      os << "vix_db_pool_connections{pool=\"" << p << "\",state=\"idle\"} " << s.idle << '\n';
+    }
+
+    family(os, pools, "vix_db_pool_max_connections", "gauge",
+           "Configured maximum number of connections.",
+           [](const PoolStats &s)
+           { return s.max; });
+    family(os, pools, "vix_db_pool_waiters", "gauge",
+           "Callers blocked waiting for a connection.",
+           [](const PoolStats &s)
+           { return s.waiters; });
+    family(os, pools, "vix_db_pool_connections_created_total", "counter",
+           "Connections opened by the pool.",
+           [](const PoolStats &s)
+           { return s.created; });
+    family(os, pools, "vix_db_pool_connections_destroyed_total", "counter",
+           "Connections closed by the pool.",
+           [](const PoolStats &s)
+           { return s.destroyed; });
+    family(os, pools, "vix_db_pool_acquire_timeouts_total", "counter",
+           "Acquire calls that gave up on their deadline.",
+           [](const PoolStats &s)
+           { return s.timeouts; });
+
+    histogram(os, pools, "vix_db_pool_acquire_wait_seconds",
+              "Time spent acquiring a connection.",
+              [](const PoolStats &s) -> const HistogramSnapshot &
+              { return s.acquire_wait; });
+    histogram(os, pools, "vix_db_pool_connect_seconds",
+              "Time spent opening a new connection.",
+              [](const PoolStats &s) -> const HistogramSnapshot &
+              { return s.connect_time; });
+
+    return os.str();
+  }
+
+} // namespace vix::db
@@ -0,0 +1,84 @@
+/**
+ *
+ *  @file ReplicaPool.cpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#include <vix/db/pool/ReplicaPool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace vix::db
+{
+  namespace
+  {
+    using Clock = ConnectionPool::Clock;
+
+    constexpr std::chrono::milliseconds kBackoffBase{250};
+    constexpr std::chrono::milliseconds kBackoffMax{30000};
+
+    Clock::duration backoff_for(std::uint32_t failures)
+    {
+      const auto shift = std::min<std::uint32_t>(failures > 0 ? failures - 1 : 0, 7);
+      return std::min<Clock::duration>(kBackoffBase * (1 << shift), kBackoffMax);
+    }
+  } // namespace
+
+  ReplicaPool::ReplicaPool(std::string name, ConnectionFactory factory, const PoolConfig &cfg)
+      : name_(std::move(name)), pool_(std::move(factory), cfg)
+  {
+  }
+
+  bool ReplicaPool::healthy() const noexcept
+  {
+    return retry_at_.load(std::memory_order_acquire) <= Clock::now().time_since_epoch().count();
+  }
+
+  void ReplicaPool::markFailed() noexcept
+  {
+    const auto n = failures_.fetch_add(1, std::memory_order_relaxed) + 1;
+    const auto until = Clock::now() + backoff_for(n);
+    retry_at_.store(until.time_since_epoch().count(), std::memory_order_release);
+  }
+
+  void ReplicaPool::markHealthy() noexcept
+  {
+    // Cheap check first: this runs on every successful lease.
+    if (failures_.load(std::memory_order_relaxed) == 0)
+      return;
+    failures_.store(0, std::memory_order_relaxed);
+    retry_at_.store(0, std::memory_order_release);
+  }
+
+  RoutedConn ReplicaPool::lease()
+  {
+    outstanding_.fetch_add(1, std::memory_order_relaxed);
+    try
+    {
+      PooledConn c(pool_);
+      markHealthy();
+      return RoutedConn(std::move(c), this);
+    }
+    catch (const PoolTimeout &)
+    {
+      // Saturated, not broken: leave the health state alone.
+      outstanding_.fetch_sub(1, std::memory_order_relaxed);
+      throw;
+    }
+    catch (...)
+    {
+      outstanding_.fetch_sub(1, std::memory_order_relaxed);
+      markFailed();
+      throw;
+    }
+  }
+
+} // namespace vix::db
@@ -15,6 +15,10 @@
 #include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
 
 #include <cstring>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace vix::db
 {
@@ -24,15 +28,122 @@ namespace vix::db
     throw DBError(std::string(prefix) + ": " + msg);
   }
 
+  // SQLite has no SQLSTATE: the class comes from the extended result
+  // code. SQLITE_LOCKED is a conflict inside the process (shared cache),
+  // reported like SQLITE_BUSY.
+  static DbErrorCode classify_sqlite(int rc) noexcept
+  {
+    switch (rc)
+    {
+    case SQLITE_CONSTRAINT_UNIQUE:
+    case SQLITE_CONSTRAINT_PRIMARYKEY:
+      return DbErrorCode::DuplicateKey;
+    default:
+      break;
+    }
+    switch (rc & 0xff)
+    {
+    case SQLITE_CONSTRAINT:
+      return DbErrorCode::ConstraintViolation;
+    case SQLITE_BUSY:
+    case SQLITE_LOCKED:
+      return DbErrorCode::Busy;
+    default:
+      return DbErrorCode::Other;
+    }
+  }
+
+  static ErrorInfo sqlite_error(sqlite3 *db, const char *prefix)
+  {
+    const int rc = sqlite3_extended_errcode(db);
+    return ErrorInfo{classify_sqlite(rc), rc, {},
+                     std::string(prefix) + ": " + sqlite3_errmsg(db)};
+  }
+
+  static void exec_sql(sqlite3 *db, const char *sql, const char *prefix)
+  {
+    if (sqlite3_exec(db, sql, nullptr, nullptr, nullptr) != SQLITE_OK)
+      throw_sqlite(db, prefix);
+  }
+
+  // -------------------- Statement lease --------------------
+
+  // Statement handle taken from a connection's cache, shared by the
+  // Statement and the result sets it produced. When the last of them
+  // is gone the handle is reset, its bindings are cleared and it goes
+  // back to the cache; without a cache it is simply finalized.
+  class SQLiteStmtLease
+  {
+    SQLiteStatementCache *cache_ = nullptr;
+    SQLiteStatementCache::Entry entry_;
+    std::uint64_t run_ = 0;
+
+  public:
+    SQLiteStmtLease(SQLiteStatementCache *cache, SQLiteStatementCache::Entry entry) noexcept
+        : cache_(cache), entry_(std::move(entry)) {}
+
+    ~SQLiteStmtLease()
+    {
+      if (!cache_ || !entry_.handle)
+        return;
+
+      sqlite3_reset(get());
+      sqlite3_clear_bindings(get());
+      try
+      {
+        cache_->put(std::move(entry_));
+      }
+      catch (...)
+      {
+        // Allocation failure: the handle is finalized instead.
+      }
+    }
+
+    SQLiteStmtLease(const SQLiteStmtLease &) = delete;
+    SQLiteStmtLease &operator=(const SQLiteStmtLease &) = delete;
+
+    sqlite3_stmt *get() const noexcept { return entry_.handle.get(); }
+
+    // Starts a new execution, keeping the bindings. Rows pending from
+    // the previous one are dropped and its result set becomes stale.
+    std::uint64_t restart() noexcept
+    {
+      sqlite3_reset(get());
+      return ++run_;
+    }
+
+    bool current(std::uint64_t run) const noexcept { return run == run_; }
+  };
+
   // -------------------- Result --------------------
 
   class SQLiteResultRow final : public ResultRow
   {
     sqlite3_stmt *stmt_ = nullptr;
+    mutable std::optional<ColumnTable> columns_;
 
   public:
     explicit SQLiteResultRow(sqlite3_stmt *stmt) : stmt_(stmt) {}
 
+    const ColumnTable &columns() const override
+    {
+      if (!columns_)
+      {
+        const int n = sqlite3_column_count(stmt_);
+        std::vector<ColumnInfo> cols(static_cast<std::size_t>(n));
+        for (int c = 0; c < n; ++c)
+        {
+          auto &col = cols[static_cast<std::size_t>(c)];
+          if (const char *name = sqlite3_column_name(stmt_, c))
+            col.name = name;
+          if (const char *type = sqlite3_column_decltype(stmt_, c))
+            col.type = type;
+        }
+        columns_.emplace(std::move(cols));
+      }
+      return *columns_;
+    }
+
     bool isNull(std::size_t i) const override
     {
       return sqlite3_column_type(stmt_, static_cast<int>(i)) == SQLITE_NULL;
@@ -40,10 +151,26 @@ namespace vix::db
 
     std::string getString(std::size_t i) const override
     {
-      const unsigned char *txt = sqlite3_column_text(stmt_, static_cast<int>(i));
+      return std::string(getStringView(i));
+    }
+
+    std::string_view getStringView(std::size_t i) const override
+    {
+      // text first, then its size: the byte count is for that encoding
+      const int c = static_cast<int>(i);
+      const auto *txt = reinterpret_cast<const char *>(sqlite3_column_text(stmt_, c));
       if (!txt)
         return {};
-      return std::string(reinterpret_cast<const char *>(txt));
+      return {txt, static_cast<std::size_t>(sqlite3_column_bytes(stmt_, c))};
+    }
+
+    std::span<const std::byte> getBlob(std::size_t i) const override
+    {
+      const int c = static_cast<int>(i);
+      const auto *p = static_cast<const std::byte *>(sqlite3_column_blob(stmt_, c));
+      if (!p)
+        return {};
+      return {p, static_cast<std::size_t>(sqlite3_column_bytes(stmt_, c))};
     }
 
     std::int64_t getInt64(std::size_t i) const override
@@ -55,30 +182,148 @@ namespace vix::db
     {
       return sqlite3_column_double(stmt_, static_cast<int>(i));
     }
+
+    void decode(std::span<Cell> cells, std::size_t first) const override
+    {
+      // Each sqlite3_column_* call takes the connection mutex; the value
+      // is read once and decoded with sqlite3_value_*, which does not.
+      // The connection is used by one thread at a time, so reading the
+      // unprotected value is safe.
+      for (std::size_t k = 0; k < cells.size(); ++k)
+      {
+        Cell &cell = cells[k];
+        sqlite3_value *v = sqlite3_column_value(stmt_, static_cast<int>(first + k));
+        cell.null = sqlite3_value_type(v) == SQLITE_NULL;
+        if (cell.null)
+          continue;
+
+        switch (cell.kind)
+        {
+        case Cell::Kind::Int64:
+          cell.i = static_cast<std::int64_t>(sqlite3_value_int64(v));
+          break;
+        case Cell::Kind::Double:
+          cell.d = sqlite3_value_double(v);
+          break;
+        case Cell::Kind::Text:
+        {
+          const auto *txt = reinterpret_cast<const char *>(sqlite3_value_text(v));
+          cell.text = {txt ? txt : "", static_cast<std::size_t>(sqlite3_value_bytes(v))};
+          break;
+        }
+        case Cell::Kind::Blob:
+        {
+          const auto *p = static_cast<const std::byte *>(sqlite3_value_blob(v));
+          cell.bytes = {p, p ? static_cast<std::size_t>(sqlite3_value_bytes(v)) : 0};
+          break;
+        }
+        }
+      }
+    }
+
+    Cell getCell(std::size_t i) const override
+    {
+      // Same single read as decode().
+      Cell cell;
+      sqlite3_value *v = sqlite3_column_value(stmt_, static_cast<int>(i));
+      switch (sqlite3_value_type(v))
+      {
+      case SQLITE_INTEGER:
+        cell.kind = Cell::Kind::Int64;
+        cell.i = static_cast<std::int64_t>(sqlite3_value_int64(v));
+        break;
+      case SQLITE_FLOAT:
+        cell.kind = Cell::Kind::Double;
+        cell.d = sqlite3_value_double(v);
+        break;
+      case SQLITE_TEXT:
+      {
+        const auto *txt = reinterpret_cast<const char *>(sqlite3_value_text(v));
+        cell.kind = Cell::Kind::Text;
+        cell.text = {txt ? txt : "", static_cast<std::size_t>(sqlite3_value_bytes(v))};
+        break;
+      }
+      case SQLITE_BLOB:
+      {
+        const auto *p = static_cast<const std::byte *>(sqlite3_value_blob(v));
+        cell.kind = Cell::Kind::Blob;
+        cell.bytes = {p, p ? static_cast<std::size_t>(sqlite3_value_bytes(v)) : 0};
+        break;
+      }
+      default:
+        cell.null = true;
+        break;
+      }
+      return cell;
+    }
+
+    DbValue getValue(std::size_t i) const override
+    {
+      const int c = static_cast<int>(i);
+      switch (sqlite3_column_type(stmt_, c))
+      {
+      case SQLITE_INTEGER:
+        return i64(sqlite3_column_int64(stmt_, c));
+      case SQLITE_FLOAT:
+        return f64(sqlite3_column_double(stmt_, c));
+      case SQLITE_TEXT:
+      {
+        const auto *txt = reinterpret_cast<const char *>(sqlite3_column_text(stmt_, c));
+        return str(std::string(txt, static_cast<std::size_t>(sqlite3_column_bytes(stmt_, c))));
+      }
+      case SQLITE_BLOB:
+      {
+        const auto *p = static_cast<const std::uint8_t *>(sqlite3_column_blob(stmt_, c));
+        const auto n = static_cast<std::size_t>(sqlite3_column_bytes(stmt_, c));
+        return blob(p ? std::vector<std::uint8_t>(p, p + n) : std::vector<std::uint8_t>{});
+      }
+      default:
+        return null();
+      }
+    }
   };
 
+  // Borrows the statement: destroying the result set resets it and
+  // clears its bindings, ready for the next bind/query round.
   class SQLiteResultSet final : public ResultSet
   {
-    sqlite3_stmt *stmt_ = nullptr;
+    std::shared_ptr<SQLiteStmtLease> stmt_;
+    std::uint64_t run_;
     mutable SQLiteResultRow row_;
     bool has_row_ = false;
+    bool done_ = false;
+    bool stepped_ = false; // first row already fetched by tryQuery()
 
   public:
-    explicit SQLiteResultSet(sqlite3_stmt *stmt)
-        : stmt_(stmt), row_(stmt) {}
+    SQLiteResultSet(std::shared_ptr<SQLiteStmtLease> stmt, std::uint64_t run)
+        : stmt_(std::move(stmt)), run_(run), row_(stmt_->get()) {}
 
     ~SQLiteResultSet() override
     {
-      if (stmt_)
-        sqlite3_finalize(stmt_);
+      // A newer execution of the statement owns its state now.
+      if (!stmt_->current(run_))
+        return;
+
+      sqlite3_reset(stmt_->get());
+      sqlite3_clear_bindings(stmt_->get());
     }
 
     bool next() override
     {
-      if (!stmt_)
+      if (!stmt_->current(run_))
+        throw DBError("SQLiteResultSet::next() after its statement was re-executed");
+
+      // stepping past SQLITE_DONE would run the statement again
+      if (done_)
         return false;
+      if (stepped_)
+      {
+        stepped_ = false;
+        has_row_ = true;
+        return true;
+      }
 
-      const int rc = sqlite3_step(stmt_);
+      const int rc = sqlite3_step(stmt_->get());
       if (rc == SQLITE_ROW)
       {
         has_row_ = true;
@@ -87,17 +332,29 @@ namespace vix::db
       if (rc == SQLITE_DONE)
       {
         has_row_ = false;
+        done_ = true;
         return false;
       }
-      throw_sqlite(sqlite3_db_handle(stmt_), "SQLite step failed");
+      throw_sqlite(sqlite3_db_handle(stmt_->get()), "SQLite step failed");
       return false;
     }
 
+    // Result of a first sqlite3_step() made before handing the set out
+    void firstStep(int rc) noexcept
+    {
+      if (rc == SQLITE_ROW)
+        stepped_ = true;
+      else
+        done_ = true;
+    }
+
     std::size_t cols() const override
     {
-      return stmt_ ? static_cast<std::size_t>(sqlite3_column_count(stmt_)) : 0;
+      return static_cast<std::size_t>(sqlite3_column_count(stmt_->get()));
     }
 
+    const ColumnTable &columns() const override { return row_.columns(); }
+
     const ResultRow &row() const override
     {
       if (!has_row_)
@@ -111,7 +368,7 @@ namespace vix::db
   class SQLiteStatement final : public Statement
   {
     sqlite3 *db_ = nullptr;
-    sqlite3_stmt *stmt_ = nullptr;
+    std::shared_ptr<SQLiteStmtLease> stmt_;
 
     static int idx1(std::size_t i)
     {
@@ -119,99 +376,197 @@ namespace vix::db
       return static_cast<int>(i);
     }
 
+    sqlite3_stmt *bindable()
+    {
+      sqlite3_stmt *st = stmt_->get();
+      if (!st)
+        throw DBError("SQLiteStatement::bind on null stmt");
+
+      // Rebinding while a result set is still open ends that result set.
+      if (sqlite3_stmt_busy(st))
+        stmt_->restart();
+      return st;
+    }
+
+    void check_bind(int rc)
+    {
+      if (rc != SQLITE_OK)
+        throw_sqlite(db_, "SQLite bind failed");
+    }
+
+    // SQLITE_STATIC binds the caller's bytes, SQLITE_TRANSIENT copies them.
+    // A null pointer would bind NULL, so empty text points at "".
+    void bind_text(std::size_t idx, std::string_view v, sqlite3_destructor_type how)
+    {
+      check_bind(sqlite3_bind_text64(bindable(), idx1(idx), v.data() ? v.data() : "",
+                                     static_cast<sqlite3_uint64>(v.size()), how, SQLITE_UTF8));
+    }
+
+    void bind_blob(std::size_t idx, std::span<const std::byte> v, sqlite3_destructor_type how)
+    {
+      sqlite3_stmt *st = bindable();
+      check_bind(v.empty()
+                     ? sqlite3_bind_zeroblob(st, idx1(idx), 0)
+                     : sqlite3_bind_blob64(st, idx1(idx), v.data(),
+                                           static_cast<sqlite3_uint64>(v.size()), how));
+    }
+
   public:
-    SQLiteStatement(sqlite3 *db, sqlite3_stmt *stmt)
-        : db_(db), stmt_(stmt) {}
+    SQLiteStatement(sqlite3 *db, std::shared_ptr<SQLiteStmtLease> stmt)
+        : db_(db), stmt_(std::move(stmt)) {}
 
-    ~SQLiteStatement() override
+    void bindNull(std::size_t idx) override
     {
-      if (stmt_)
-        sqlite3_finalize(stmt_);
+      check_bind(sqlite3_bind_null(bindable(), idx1(idx)));
     }
 
-    void bind(std::size_t idx, const DbValue &v) override
+    void bindInt64(std::size_t idx, std::int64_t v) override
     {
-      if (!stmt_)
-        throw DBError("SQLiteStatement::bind on null stmt");
+      check_bind(sqlite3_bind_int64(bindable(), idx1(idx), static_cast<sqlite3_int64>(v)));
+    }
 
-      const int i = idx1(idx);
-
-      const int rc = std::visit(
-          [&](auto &&val) -> int
-          {
-            using T = std::decay_t<decltype(val)>;
-
-            if constexpr (std::is_same_v<T, std::nullptr_t>)
-            {
-              return sqlite3_bind_null(stmt_, i);
-            }
-            else if constexpr (std::is_same_v<T, bool>)
-            {
-              return sqlite3_bind_int(stmt_, i, val ? 1 : 0);
-            }
-            else if constexpr (std::is_same_v<T, std::int64_t>)
-            {
-              return sqlite3_bind_int64(stmt_, i, static_cast<sqlite3_int64>(val));
-            }
-            else if constexpr (std::is_same_v<T, double>)
-            {
-              return sqlite3_bind_double(stmt_, i, val);
-            }
-            else if constexpr (std::is_same_v<T, std::string>)
-            {
-              // SQLITE_TRANSIENT => sqlite copies the bytes
-              return sqlite3_bind_text(stmt_, i, val.c_str(), static_cast<int>(val.size()), SQLITE_TRANSIENT);
-            }
-            else if constexpr (std::is_same_v<T, Blob>)
-            {
-              const void *p = val.bytes.empty() ? nullptr : val.bytes.data();
-              const int n = static_cast<int>(val.bytes.size());
-              return sqlite3_bind_blob(stmt_, i, p, n, SQLITE_TRANSIENT);
-            }
-            else
-            {
-              return SQLITE_MISUSE;
-            }
-          },
-          v);
+    void bindDouble(std::size_t idx, double v) override
+    {
+      check_bind(sqlite3_bind_double(bindable(), idx1(idx), v));
+    }
 
-      if (rc != SQLITE_OK)
-        throw_sqlite(db_, "SQLite bind failed");
+    void bindText(std::size_t idx, std::string_view v) override
+    {
+      bind_text(idx, v, SQLITE_STATIC);
+    }
+
+    void bindBlob(std::size_t idx, std::span<const std::byte> v) override
+    {
+      bind_blob(idx, v, SQLITE_STATIC);
+    }
+
+    void bindTextCopy(std::size_t idx, std::string_view v) override
+    {
+      bind_text(idx, v, SQLITE_TRANSIENT);
+    }
+
+    void bindBlobCopy(std::size_t idx, std::span<const std::byte> v) override
+    {
+      bind_blob(idx, v, SQLITE_TRANSIENT);
+    }
+
+    // SQLite has no temporal or exact decimal storage class: instants
+    // and days are stored as integers, decimals in their binary form.
+    void bindTimestamp(std::size_t idx, Timestamp v) override
+    {
+      bindInt64(idx, v.micros);
+    }
+
+    void bindDate(std::size_t idx, Date v) override
+    {
+      bindInt64(idx, v.days);
+    }
+
+    void bindDecimal(std::size_t idx, const Decimal &v) override
+    {
+      const auto bytes = to_bytes(v);
+      bind_blob(idx, bytes, SQLITE_TRANSIENT);
     }
 
     std::unique_ptr<ResultSet> query() override
     {
-      if (!stmt_)
+      if (!stmt_->get())
         throw DBError("SQLiteStatement::query on null stmt");
 
-      // query returns ResultSet that owns stmt_
-      auto *st = stmt_;
-      stmt_ = nullptr;
-      return std::make_unique<SQLiteResultSet>(st);
+      // the ResultSet borrows the statement, which stays reusable
+      const auto run = stmt_->restart();
+      return std::make_unique<SQLiteResultSet>(stmt_, run);
     }
 
-    std::uint64_t exec() override
+    Expected<std::unique_ptr<ResultSet>> tryQuery() override
     {
-      if (!stmt_)
+      if (!stmt_->get())
+        throw DBError("SQLiteStatement::query on null stmt");
+
+      // Lock conflicts surface on the first step, taken here.
+      const auto run = stmt_->restart();
+      const int rc = sqlite3_step(stmt_->get());
+      if (rc != SQLITE_DONE && rc != SQLITE_ROW)
+      {
+        ErrorInfo e = sqlite_error(db_, "SQLite step failed");
+        sqlite3_reset(stmt_->get());
+        sqlite3_clear_bindings(stmt_->get());
+        if (e.code == DbErrorCode::Other)
+          raise(e);
+        return e;
+      }
+
+      auto rs = std::make_unique<SQLiteResultSet>(stmt_, run);
+      rs->firstStep(rc);
+      return std::unique_ptr<ResultSet>(std::move(rs));
+    }
+
+    std::uint64_t exec() override { return tryExec().value(); }
+
+    Expected<std::uint64_t> tryExec() override
+    {
+      if (!stmt_->get())
         throw DBError("SQLiteStatement::exec on null stmt");
 
-      const int rc = sqlite3_step(stmt_);
+      stmt_->restart();
+      const int rc = sqlite3_step(stmt_->get());
       if (rc != SQLITE_DONE && rc != SQLITE_ROW)
-        throw_sqlite(db_, "SQLite exec failed");
+      {
+        // a failed step leaves the statement halted, reset it so it can
+        // be bound again
+        ErrorInfo e = sqlite_error(db_, "SQLite exec failed");
+        sqlite3_reset(stmt_->get());
+        sqlite3_clear_bindings(stmt_->get());
+        if (e.code == DbErrorCode::Other)
+          raise(e);
+        return e;
+      }
 
       const auto changes = static_cast<std::uint64_t>(sqlite3_changes(db_));
 
       // reset for reuse
-      sqlite3_reset(stmt_);
-      sqlite3_clear_bindings(stmt_);
+      sqlite3_reset(stmt_->get());
+      sqlite3_clear_bindings(stmt_->get());
       return changes;
     }
+
+    std::vector<std::uint64_t> execBatch(const ParamBatch &batch) override
+    {
+      std::vector<std::uint64_t> counts;
+      if (batch.empty())
+        return counts;
+      counts.reserve(batch.size());
+
+      // A savepoint opens a transaction when none is active, so the
+      // batch costs a single journal commit, and keeps it all-or-nothing
+      // inside a caller's transaction as well.
+      exec_sql(db_, "SAVEPOINT vix_batch", "SQLite batch failed");
+      try
+      {
+        for (std::size_t r = 0; r < batch.size(); ++r)
+        {
+          const auto row = batch.row(r);
+          for (std::size_t i = 0; i < row.size(); ++i)
+            bind(i + 1, row[i]);
+          counts.push_back(exec());
+        }
+        exec_sql(db_, "RELEASE vix_batch", "SQLite batch commit failed");
+      }
+      catch (...)
+      {
+        sqlite3_exec(db_, "ROLLBACK TO vix_batch; RELEASE vix_batch", nullptr, nullptr, nullptr);
+        throw;
+      }
+      return counts;
+    }
   };
 
   // -------------------- Connection --------------------
 
   SQLiteConnection::~SQLiteConnection()
   {
+    // Cached statements would keep sqlite3_close() from closing db_.
+    cache_.clear();
     if (db_)
       sqlite3_close(db_);
   }
@@ -221,6 +576,13 @@ namespace vix::db
     if (!db_)
       throw DBError("SQLiteConnection::prepare on null db");
 
+    if (cache_.enabled())
+    {
+      if (auto hit = cache_.take(sql))
+        return std::make_unique<SQLiteStatement>(
+            db_, std::make_shared<SQLiteStmtLease>(&cache_, std::move(*hit)));
+    }
+
     sqlite3_stmt *stmt = nullptr;
     const int rc = sqlite3_prepare_v2(
         db_,
@@ -232,7 +594,9 @@ namespace vix::db
     if (rc != SQLITE_OK || !stmt)
       throw_sqlite(db_, "SQLite prepare failed");
 
-    return std::make_unique<SQLiteStatement>(db_, stmt);
+    SQLiteStatementCache::Entry entry{std::string(sql), SQLiteStmtHandle(stmt)};
+    return std::make_unique<SQLiteStatement>(
+        db_, std::make_shared<SQLiteStmtLease>(cache_.enabled() ? &cache_ : nullptr, std::move(entry)));
   }
 
   void SQLiteConnection::begin()
@@ -257,6 +621,15 @@ namespace vix::db
     return static_cast<std::uint64_t>(sqlite3_last_insert_rowid(db_));
   }
 
+  InsertLimits SQLiteConnection::insertLimits()
+  {
+    InsertLimits limits;
+    if (db_)
+      limits.max_params = static_cast<std::size_t>(
+          sqlite3_limit(db_, SQLITE_LIMIT_VARIABLE_NUMBER, -1));
+    return limits;
+  }
+
   sqlite3 *open_sqlite(const std::string &path)
   {
     sqlite3 *db = nullptr;
@@ -277,12 +650,12 @@ namespace vix::db
     return db;
   }
 
-  ConnectionFactory make_sqlite_factory(std::string path)
+  ConnectionFactory make_sqlite_factory(std::string path, std::size_t statement_cache)
   {
-    return [path = std::move(path)]() -> ConnectionPtr
+    return [path = std::move(path), statement_cache]() -> ConnectionPtr
     {
       sqlite3 *db = open_sqlite(path);
-      auto c = std::make_shared<SQLiteConnection>(db);
+      auto c = std::make_shared<SQLiteConnection>(db, statement_cache);
       return std::static_pointer_cast<Connection>(c);
     };
   }
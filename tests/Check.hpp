@@ -0,0 +1,80 @@
+/**
+ *
+ *  @file Check.hpp
+ *  @author Gaspard Kirira
+ *
+ *  Copyright 2025, Gaspard Kirira.
+ *  All rights reserved.
+ *  https://github.com/vixcpp/vix
+ *
+ *  Use of this source code is governed by a MIT license
+ *  that can be found in the License file.
+ *
+ *  Vix.cpp
+ */
+#ifndef VIX_DB_TESTS_CHECK_HPP
+#define VIX_DB_TESTS_CHECK_HPP
+
+#include <exception>
+#include <iostream>
+
+/**
+ * Minimal assertions for the Vix DB tests: each test is an executable
+ * whose exit status is the number of failed checks, capped at 1, so
+ * that ctest needs no framework.
+ */
+namespace vix::db::test
+{
+  inline int &failures() noexcept
+  {
+    static int n = 0;
+    return n;
+  }
+
+  inline void fail(const char *what, const char *file, int line)
+  {
+    std::cerr << file << ":" << line << ": check failed: " << what << "\n";
+    ++failures();
+  }
+
+  /// Run one case, counting an escaping exception as a failure
+  template <typename Fn>
+  void run(const char *name, Fn &&fn)
+  {
+    try
+    {
+      fn();
+    }
+    catch (const std::exception &e)
+    {
+      std::cerr << name << ": unexpected exception: " << e.what() << "\n";
+      ++failures();
+    }
+  }
+
+  inline int report()
+  {
+    return failures() == 0 ? 0 : 1;
+  }
+} // namespace vix::db::test
+
+#define VIX_CHECK(expr) \
+  ((expr) ? void(0) : ::vix::db::test::fail(#expr, __FILE__, __LINE__))
+
+#define VIX_CHECK_THROWS(stmt, Ex)                                      \
+  do                                                                    \
+  {                                                                     \
+    bool vix_threw_ = false;                                            \
+    try                                                                 \
+    {                                                                   \
+      stmt;                                                             \
+    }                                                                   \
+    catch (const Ex &)                                                  \
+    {                                                                   \
+      vix_threw_ = true;                                                \
+    }                                                                   \
+    if (!vix_threw_)                                                    \
+      ::vix::db::test::fail(#stmt " throws " #Ex, __FILE__, __LINE__);  \
+  } while (0)
+
+#endif // VIX_DB_TESTS_CHECK_HPP
@@ -0,0 +1,123 @@
+// Statement::execBatch atomicity and Connection::insertMany chunking.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace vix::db;
+
+namespace
+{
+  std::int64_t count(Connection &c, const char *table)
+  {
+    auto rs = c.prepare(std::string("SELECT count(*) FROM ") + table)->query();
+    rs->next();
+    return rs->row().getInt64(0);
+  }
+
+  void batchRollsBack()
+  {
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE t (id INTEGER PRIMARY KEY, v TEXT)")->exec();
+
+    ParamBatch batch(2);
+    batch.add(1, "a");
+    batch.add(2, "b");
+    batch.add(1, "duplicate");
+    batch.add(3, "c");
+
+    auto st = conn->prepare("INSERT INTO t VALUES (?, ?)");
+    VIX_CHECK_THROWS(st->execBatch(batch), DBError);
+    VIX_CHECK(count(*conn, "t") == 0);
+
+    // Inside a caller's transaction only the batch is undone.
+    conn->begin();
+    conn->prepare("INSERT INTO t VALUES (10, 'kept')")->exec();
+    VIX_CHECK_THROWS(st->execBatch(batch), DBError);
+    conn->commit();
+    VIX_CHECK(count(*conn, "t") == 1);
+
+    ParamBatch good(2);
+    good.add(1, "a");
+    good.add(2, "b");
+    const auto counts = st->execBatch(good);
+    VIX_CHECK(counts.size() == 2 && counts[0] == 1 && counts[1] == 1);
+    VIX_CHECK(count(*conn, "t") == 3);
+  }
+
+  void insertManyChunks()
+  {
+    // 3 columns: chunks of kMaxInsertRows rows, then power-of-two tails.
+    for (const std::size_t rows : {std::size_t{1}, kMaxInsertRows - 1, kMaxInsertRows,
+                                   kMaxInsertRows + 1, 2 * kMaxInsertRows + 37})
+    {
+      auto conn = make_sqlite_factory(":memory:")();
+      conn->prepare("CREATE TABLE t (id INTEGER, name TEXT, score REAL)")->exec();
+
+      ParamBatch batch(3);
+      std::int64_t sum = 0;
+      for (std::size_t i = 0; i < rows; ++i)
+      {
+        const auto id = static_cast<std::int64_t>(i);
+        batch.add(id, "n" + std::to_string(i), static_cast<double>(i) / 2);
+        sum += id;
+      }
+
+      VIX_CHECK(conn->insertMany("t", {"id", "name", "score"}, batch) == rows);
+
+      auto rs = conn->prepare("SELECT count(*), sum(id), count(DISTINCT id), "
+                              "sum(name = 'n' || id), sum(score * 2 = id) FROM t")
+                    ->query();
+      rs->next();
+      const auto &r = rs->row();
+      VIX_CHECK(static_cast<std::size_t>(r.getInt64(0)) == rows);
+      VIX_CHECK(r.getInt64(1) == sum);
+      VIX_CHECK(static_cast<std::size_t>(r.getInt64(2)) == rows);
+      VIX_CHECK(static_cast<std::size_t>(r.getInt64(3)) == rows);
+      VIX_CHECK(static_cast<std::size_t>(r.getInt64(4)) == rows);
+    }
+  }
+
+  void insertManyWide()
+  {
+    // Wide rows are bounded by the placeholder limit, not the row cap.
+    auto conn = make_sqlite_factory(":memory:")();
+    constexpr std::size_t width = 1500; // under SQLite's 2000 columns
+    const std::size_t per_chunk = conn->insertLimits().max_params / width;
+
+    std::string ddl = "CREATE TABLE w (";
+    std::vector<std::string> columns;
+    for (std::size_t c = 0; c < width; ++c)
+    {
+      columns.push_back("c" + std::to_string(c));
+      ddl += (c ? ", " : "") + columns.back() + " INTEGER";
+    }
+    conn->prepare(ddl + ")")->exec();
+
+    ParamBatch batch(width);
+    std::vector<DbValue> row(width);
+    const auto rows = static_cast<std::int64_t>(2 * per_chunk + 3);
+    for (std::int64_t i = 0; i < rows; ++i)
+    {
+      for (std::size_t c = 0; c < width; ++c)
+        row[c] = i;
+      batch.addRow(row);
+    }
+
+    VIX_CHECK(conn->insertMany("w", columns, batch) == static_cast<std::uint64_t>(rows));
+    VIX_CHECK(count(*conn, "w") == rows);
+  }
+} // namespace
+
+int main()
+{
+  test::run("batchRollsBack", batchRollsBack);
+  test::run("insertManyChunks", insertManyChunks);
+  test::run("insertManyWide", insertManyWide);
+  return test::report();
+}
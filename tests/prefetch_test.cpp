@@ -0,0 +1,92 @@
+// prefetch(): rows in order, and driver errors delivered after the rows
+// read before them.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace vix::db;
+
+namespace
+{
+  ConnectionPtr filled(std::int64_t rows)
+  {
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE t (id INTEGER, name TEXT)")->exec();
+
+    ParamBatch batch(2);
+    for (std::int64_t i = 0; i < rows; ++i)
+      batch.add(i, "row " + std::to_string(i));
+    conn->insertMany("t", {"id", "name"}, batch);
+    return conn;
+  }
+
+  void inOrder()
+  {
+    auto conn = filled(1000);
+    auto rs = prefetch(conn->prepare("SELECT id, name FROM t ORDER BY id")->query(), 64);
+
+    std::int64_t i = 0;
+    for (const auto &r : *rs)
+    {
+      VIX_CHECK(r.getInt64(0) == i);
+      VIX_CHECK(r.getString(1) == "row " + std::to_string(i));
+      ++i;
+    }
+    VIX_CHECK(i == 1000);
+    VIX_CHECK(!rs->next());
+  }
+
+  void errorAfterRows()
+  {
+    // abs() of the smallest integer fails at run time, on row 100; no
+    // ORDER BY, which would evaluate every row before the first
+    auto conn = filled(1000);
+    auto rs = prefetch(conn->prepare("SELECT CASE WHEN id < 100 THEN id "
+                                     "ELSE abs(-9223372036854775807 - 1) END "
+                                     "FROM t")
+                           ->query(),
+                       32);
+
+    std::int64_t seen = 0;
+    bool threw = false;
+    try
+    {
+      while (rs->next())
+      {
+        VIX_CHECK(rs->row().getInt64(0) == seen);
+        ++seen;
+      }
+    }
+    catch (const DBError &)
+    {
+      threw = true;
+    }
+
+    VIX_CHECK(threw);
+    VIX_CHECK(seen == 100);
+  }
+
+  void abandoned()
+  {
+    // destroying a half-read result set stops the helper thread
+    auto conn = filled(5000);
+    {
+      auto rs = prefetch(conn->prepare("SELECT id FROM t")->query(), 16);
+      VIX_CHECK(rs->next());
+    }
+    VIX_CHECK(conn->prepare("SELECT count(*) FROM t")->query()->next());
+  }
+} // namespace
+
+int main()
+{
+  test::run("inOrder", inOrder);
+  test::run("errorAfterRows", errorAfterRows);
+  test::run("abandoned", abandoned);
+  return test::report();
+}
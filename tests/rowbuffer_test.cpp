@@ -0,0 +1,140 @@
+// RowBuffer: in-memory and spilled copies of a result set.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace vix::db;
+
+namespace
+{
+  constexpr std::int64_t kRows = 20'000;
+
+  ConnectionPtr filled()
+  {
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE t (id INTEGER, name TEXT, score REAL, data BLOB, maybe INTEGER)")->exec();
+
+    ParamBatch batch(5);
+    for (std::int64_t i = 0; i < kRows; ++i)
+    {
+      // text lengths around the short-string size, blobs up to 300 bytes
+      batch.add(i, std::string(static_cast<std::size_t>(i % 40), 'a' + static_cast<char>(i % 26)),
+                static_cast<double>(i) * 0.25,
+                blob(std::vector<std::uint8_t>(static_cast<std::size_t>(i % 300), static_cast<std::uint8_t>(i))),
+                i % 3 ? DbValue{i} : DbValue{nullptr});
+    }
+    conn->begin();
+    conn->insertMany("t", {"id", "name", "score", "data", "maybe"}, batch);
+    conn->commit();
+    return conn;
+  }
+
+  void checkRows(RowBuffer &rows)
+  {
+    VIX_CHECK(rows.size() == static_cast<std::size_t>(kRows));
+    VIX_CHECK(rows.columns().size() == 5);
+
+    std::int64_t i = 0;
+    for (const auto &r : rows)
+    {
+      VIX_CHECK(r.getInt64(0) == i);
+      VIX_CHECK(r.getStringView(1).size() == static_cast<std::size_t>(i % 40));
+      VIX_CHECK(r.getDouble(2) == static_cast<double>(i) * 0.25);
+      const auto data = r.getBlob(3);
+      VIX_CHECK(data.size() == static_cast<std::size_t>(i % 300));
+      VIX_CHECK(data.empty() || data.back() == static_cast<std::byte>(i & 0xff));
+      VIX_CHECK(r.isNull(4) == (i % 3 == 0));
+      ++i;
+    }
+    VIX_CHECK(i == kRows);
+  }
+
+  void inMemory()
+  {
+    auto conn = filled();
+    RowBuffer rows = conn->prepare("SELECT * FROM t ORDER BY id")->query()->materialize();
+    VIX_CHECK(!rows.spilled());
+    checkRows(rows);
+
+    // copies share the rows and iterate independently
+    RowBuffer copy = rows;
+    copy.rewind();
+    checkRows(copy);
+  }
+
+  void spilled()
+  {
+    auto conn = filled();
+    MaterializeOptions opts;
+    opts.memory_limit = 64 * 1024;
+
+    RowBuffer rows = conn->prepare("SELECT * FROM t ORDER BY id")->query()->materialize(opts);
+    VIX_CHECK(rows.spilled());
+    VIX_CHECK(rows.bytes() > opts.memory_limit);
+    checkRows(rows);
+    rows.rewind();
+    checkRows(rows);
+  }
+
+  void largeRows()
+  {
+    // rows spanning several chunks move while they are encoded
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE big (id INTEGER, a TEXT, b BLOB, c TEXT)")->exec();
+    auto ins = conn->prepare("INSERT INTO big VALUES (?, ?, ?, ?)");
+    for (std::int64_t i = 0; i < 8; ++i)
+    {
+      const auto n = static_cast<std::size_t>(40'000 << i);
+      ins->bind(1, i);
+      ins->bind(2, std::string(n, 'a'));
+      ins->bind(3, blob(std::vector<std::uint8_t>(n / 2, static_cast<std::uint8_t>(i))));
+      ins->bind(4, std::string(n, 'c'));
+      ins->exec();
+    }
+
+    for (const std::size_t limit : {std::size_t{0}, std::size_t{256 * 1024}})
+    {
+      MaterializeOptions opts;
+      opts.memory_limit = limit;
+      RowBuffer rows = conn->prepare("SELECT * FROM big ORDER BY id")->query()->materialize(opts);
+      VIX_CHECK(rows.spilled() == (limit != 0));
+
+      std::int64_t i = 0;
+      for (const auto &r : rows)
+      {
+        const auto n = static_cast<std::size_t>(40'000 << i);
+        VIX_CHECK(r.getInt64(0) == i);
+        VIX_CHECK(r.getStringView(1) == std::string(n, 'a'));
+        const auto b = r.getBlob(2);
+        VIX_CHECK(b.size() == n / 2 && b.front() == static_cast<std::byte>(i) &&
+                  b.back() == static_cast<std::byte>(i));
+        VIX_CHECK(r.getStringView(3) == std::string(n, 'c'));
+        ++i;
+      }
+      VIX_CHECK(i == 8);
+    }
+  }
+
+  void empty()
+  {
+    auto conn = filled();
+    RowBuffer rows = conn->prepare("SELECT * FROM t WHERE id < 0")->query()->materialize();
+    VIX_CHECK(rows.size() == 0);
+    VIX_CHECK(!rows.next());
+  }
+} // namespace
+
+int main()
+{
+  test::run("inMemory", inMemory);
+  test::run("spilled", spilled);
+  test::run("largeRows", largeRows);
+  test::run("empty", empty);
+  return test::report();
+}
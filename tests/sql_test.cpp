@@ -0,0 +1,52 @@
+// SQL text scanning: placeholder counts and read-only routing.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+
+using namespace vix::db;
+
+namespace
+{
+  static_assert(count_placeholders("SELECT ? FROM t WHERE a = ?") == 2);
+  static_assert(count_placeholders("SELECT '?', \"?\", `?` -- ?\n, ? /* ? */") == 1);
+
+  void placeholders()
+  {
+    VIX_CHECK(count_placeholders("INSERT INTO t VALUES (?, 'it''s ?', ?)") == 2);
+    VIX_CHECK(count_placeholders("SELECT 'a\\'?' , ? # ?") == 1);
+    VIX_CHECK(count_placeholders("SELECT ? /* unterminated ?") == 1);
+    VIX_CHECK(count_placeholders("SELECT '?") == 0);
+  }
+
+  void readOnly()
+  {
+    VIX_CHECK(is_read_only_sql("SELECT * FROM t"));
+    VIX_CHECK(is_read_only_sql("  /* hint */ (select 1)"));
+    VIX_CHECK(is_read_only_sql("-- note\nSHOW TABLES"));
+    VIX_CHECK(is_read_only_sql("SELECT 'FOR UPDATE', `into` FROM t"));
+    VIX_CHECK(is_read_only_sql("SELECT a FROM t -- FOR UPDATE"));
+
+    VIX_CHECK(!is_read_only_sql("UPDATE t SET a = 1"));
+    VIX_CHECK(!is_read_only_sql("SELECT * FROM t FOR UPDATE"));
+    VIX_CHECK(!is_read_only_sql("select a into @x from t"));
+    VIX_CHECK(!is_read_only_sql("SELECT * FROM t LOCK IN SHARE MODE"));
+    VIX_CHECK(!is_read_only_sql("/* unterminated SELECT"));
+
+    // session state stays on the primary
+    VIX_CHECK(!is_read_only_sql("SELECT LAST_INSERT_ID()"));
+    VIX_CHECK(!is_read_only_sql("select get_lock('job', 10)"));
+    VIX_CHECK(!is_read_only_sql("SELECT RELEASE_LOCK ('job')"));
+    VIX_CHECK(!is_read_only_sql("SELECT FOUND_ROWS()"));
+    VIX_CHECK(!is_read_only_sql("SELECT @n := @n + 1 FROM t"));
+    VIX_CHECK(!is_read_only_sql("SELECT a FROM t WHERE b = @x"));
+    VIX_CHECK(is_read_only_sql("SELECT @@version, 'LAST_INSERT_ID()', row_count FROM t"));
+  }
+} // namespace
+
+int main()
+{
+  test::run("placeholders", placeholders);
+  test::run("readOnly", readOnly);
+  return test::report();
+}
@@ -0,0 +1,89 @@
+// Per-connection statement cache: reuse and leases held by result sets.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <cstdint>
+
+using namespace vix::db;
+
+namespace
+{
+  void reuse()
+  {
+    auto conn = make_sqlite_factory(":memory:", 4)();
+    conn->prepare("CREATE TABLE t (x INTEGER)")->exec();
+
+    for (std::int64_t i = 0; i < 10; ++i)
+    {
+      auto st = conn->prepare("INSERT INTO t VALUES (?)");
+      st->bind(1, i);
+      VIX_CHECK(st->exec() == 1);
+    }
+
+    const StatementCacheStats s = conn->statementCacheStats();
+    VIX_CHECK(s.hits == 9);
+    VIX_CHECK(s.capacity == 4);
+    VIX_CHECK(s.size <= s.capacity);
+  }
+
+  void leasedByResultSet()
+  {
+    auto conn = make_sqlite_factory(":memory:", 4)();
+    conn->prepare("CREATE TABLE t (x INTEGER)")->exec();
+    conn->prepare("INSERT INTO t VALUES (1), (2), (3)")->exec();
+
+    const char *sql = "SELECT x FROM t ORDER BY x";
+    auto rs = conn->prepare(sql)->query();
+    VIX_CHECK(rs->next());
+
+    // The open result set still holds the handle: the same SQL gets its
+    // own, and both read independently.
+    const auto misses = conn->statementCacheStats().misses;
+    auto other = conn->prepare(sql)->query();
+    VIX_CHECK(conn->statementCacheStats().misses == misses + 1);
+
+    VIX_CHECK(other->next() && other->row().getInt64(0) == 1);
+    VIX_CHECK(rs->next() && rs->row().getInt64(0) == 2);
+    VIX_CHECK(other->next() && other->row().getInt64(0) == 2);
+
+    // Destroying them returns both handles, reset, to the cache.
+    rs.reset();
+    other.reset();
+    const auto hits = conn->statementCacheStats().hits;
+    auto again = conn->prepare(sql)->query();
+    VIX_CHECK(conn->statementCacheStats().hits == hits + 1);
+
+    int n = 0;
+    while (again->next())
+      ++n;
+    VIX_CHECK(n == 3);
+  }
+
+  void reexecuteEndsResultSet()
+  {
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE t (x INTEGER)")->exec();
+    conn->prepare("INSERT INTO t VALUES (1), (2)")->exec();
+
+    auto st = conn->prepare("SELECT x FROM t WHERE x >= ?");
+    st->bind(1, 1);
+    auto first = st->query();
+    VIX_CHECK(first->next());
+
+    st->bind(1, 2);
+    auto second = st->query();
+    VIX_CHECK(second->next() && second->row().getInt64(0) == 2);
+    VIX_CHECK_THROWS(first->next(), DBError);
+  }
+} // namespace
+
+int main()
+{
+  test::run("reuse", reuse);
+  test::run("leasedByResultSet", leasedByResultSet);
+  test::run("reexecuteEndsResultSet", reexecuteEndsResultSet);
+  return test::report();
+}
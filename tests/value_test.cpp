@@ -0,0 +1,183 @@
+// Timestamp, Date, Decimal and Uuid: text forms and SQLite round-trips.
+
+#include "Check.hpp"
+
+#include <vix/db/db.hpp>
+#include <vix/db/drivers/sqlite/SQLiteDriver.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+
+using namespace vix::db;
+using namespace std::chrono;
+
+namespace
+{
+  struct Event
+  {
+    std::int64_t id = 0;
+    Timestamp at;
+    std::optional<Decimal> amount;
+  };
+  VIX_DB_FIELDS(Event, id, at, amount)
+
+  void timestampText()
+  {
+    VIX_CHECK(to_string(Timestamp{0}) == "1970-01-01 00:00:00");
+    VIX_CHECK(to_string(Timestamp{-1}) == "1969-12-31 23:59:59.999999");
+    VIX_CHECK(parse_timestamp("1969-12-31 23:59:59.999999").micros == -1);
+    VIX_CHECK(parse_timestamp("2024-02-29T12:34:56.5+02:00") ==
+              parse_timestamp("2024-02-29 10:34:56.500000"));
+    VIX_CHECK(parse_timestamp("2024-02-29T10:34:56.1234567Z") ==
+              parse_timestamp("2024-02-29 10:34:56.123456"));
+    VIX_CHECK_THROWS(parse_timestamp("2024-02-30"), DBError);
+    VIX_CHECK_THROWS(parse_timestamp("2024-02-29 24:00"), DBError);
+
+    for (const auto v : {Timestamp{0}, Timestamp{-1}, Timestamp{1'700'000'000'123'456},
+                         Timestamp::from(sys_days{1900y / 1 / 1})})
+      VIX_CHECK(parse_timestamp(to_string(v)) == v);
+
+    // years outside 0000-9999 read back as written
+    for (const auto y : {year{-1}, year{0}, year{10000}, year{-32767}, year{32767}})
+    {
+      const auto v = Timestamp::from(sys_days{y / 7 / 4} + hours{1});
+      VIX_CHECK(parse_timestamp(to_string(v)) == v);
+      const Date d = Date::from(sys_days{y / 2 / 28});
+      VIX_CHECK(parse_date(to_string(d)) == d);
+    }
+    VIX_CHECK(to_string(Date::from(sys_days{year{-1} / 1 / 1})) == "-0001-01-01");
+    VIX_CHECK_THROWS(parse_date("32768-01-01"), DBError);
+    VIX_CHECK_THROWS(parse_date("999-01-01"), DBError);
+    VIX_CHECK_THROWS(parse_date("--2024-01-01"), DBError);
+  }
+
+  void dateText()
+  {
+    VIX_CHECK(to_string(parse_date("2024-02-29 10:00:00")) == "2024-02-29");
+    VIX_CHECK(parse_date("1969-12-31").days == -1);
+    VIX_CHECK_THROWS(parse_date("2023-02-29"), DBError);
+  }
+
+  void decimalText()
+  {
+    VIX_CHECK(to_string(parse_decimal("0.05")) == "0.05");
+    VIX_CHECK(to_string(parse_decimal("-12.3400")) == "-12.3400");
+    VIX_CHECK(to_string(Decimal{0, 3}) == "0.000");
+    VIX_CHECK(to_string(Decimal{-5, 1}) == "-0.5");
+    VIX_CHECK(to_string(Decimal{1'000'000'000'000'000'000, 0}) == "1000000000000000000");
+
+    const std::string big = "-12345678901234567890123456789.012345678";
+    VIX_CHECK(to_string(parse_decimal(big)) == big);
+    VIX_CHECK_THROWS(parse_decimal("1" + std::string(38, '0')), DBError);
+
+    // scales up to 255, far beyond the 38 significant digits
+    const std::string tiny = "0." + std::string(100, '0') + "1";
+    VIX_CHECK(to_string(parse_decimal(tiny)) == tiny);
+    VIX_CHECK(to_string(Decimal{-1, 255}) == "-0." + std::string(254, '0') + "1");
+    const std::string wide = "-0." + std::string(217, '0') + std::string(38, '9');
+    VIX_CHECK(to_string(parse_decimal(wide)) == wide);
+
+    const Decimal d = parse_decimal("-99.01");
+    VIX_CHECK(decimal_from_bytes(to_bytes(d)) == d);
+    const Decimal small = {123, 255};
+    VIX_CHECK(decimal_from_bytes(to_bytes(small)) == small);
+    VIX_CHECK(to_double(parse_decimal("2.5")) == 2.5);
+  }
+
+  void uuidText()
+  {
+    const Uuid u = parse_uuid("123e4567-e89b-12d3-a456-426614174000");
+    VIX_CHECK(to_string(u) == "123e4567-e89b-12d3-a456-426614174000");
+    VIX_CHECK(parse_uuid("123E4567E89B12D3A456426614174000") == u);
+    VIX_CHECK_THROWS(parse_uuid("123e4567-e89b-12d3-a456-42661417400"), DBError);
+  }
+
+  void sqliteRoundTrip()
+  {
+    auto conn = make_sqlite_factory(":memory:")();
+    conn->prepare("CREATE TABLE t (ts, d, dec, u, txt)")->exec();
+
+    const Timestamp ts = Timestamp::from(sys_days{2024y / 3 / 1} + hours{5} + microseconds{7});
+    const Date d = Date::from(sys_days{1950y / 6 / 15});
+    const Decimal dec = parse_decimal("-1234.5678");
+    const Uuid u = parse_uuid("00112233-4455-6677-8899-aabbccddeeff");
+
+    auto ins = conn->prepare("INSERT INTO t VALUES (?, ?, ?, ?, ?)");
+    ins->bind(1, ts);
+    ins->bind(2, d);
+    ins->bind(3, dec);
+    ins->bind(4, u);
+    ins->bind(5, "2001-02-03T04:05:06Z");
+    ins->exec();
+
+    ins->bind(1, DbValue{ts});
+    ins->bind(2, DbValue{d});
+    ins->bind(3, DbValue{dec});
+    ins->bind(4, DbValue{u});
+    ins->bindNull(5);
+    ins->exec();
+
+    auto check = [&](const ResultRow &r)
+    {
+      VIX_CHECK(r.getTimestamp(0) == ts);
+      VIX_CHECK(r.getDate(1) == d);
+      VIX_CHECK(r.getDecimal(2) == dec);
+      VIX_CHECK(r.getUuid(3) == u);
+      VIX_CHECK(r.get<std::optional<Timestamp>>(4) ==
+                (r.isNull(4) ? std::nullopt : std::optional(parse_timestamp("2001-02-03 04:05:06"))));
+    };
+
+    auto rs = conn->prepare("SELECT * FROM t")->query();
+    int n = 0;
+    for (const auto &r : *rs)
+    {
+      check(r);
+      ++n;
+    }
+    VIX_CHECK(n == 2);
+
+    RowBuffer rows = conn->prepare("SELECT * FROM t")->query()->materialize();
+    for (const auto &r : rows)
+      check(r);
+
+    auto ahead = prefetch(conn->prepare("SELECT * FROM t")->query());
+    for (const auto &r : *ahead)
+      check(r);
+
+    // as() reads these columns with their getters, beside decoded ones
+    auto typed = conn->prepare("SELECT rowid, ts, d, dec, u, txt FROM t ORDER BY rowid")->query();
+    VIX_CHECK(typed->next());
+    const auto [id, t1, d1, dec1, u1, txt1] =
+        typed->as<std::tuple<std::int64_t, Timestamp, Date, Decimal, Uuid, std::optional<Timestamp>>>();
+    VIX_CHECK(id == 1 && t1 == ts && d1 == d && dec1 == dec && u1 == u);
+    VIX_CHECK(txt1 == parse_timestamp("2001-02-03 04:05:06"));
+    auto nulls = conn->prepare("SELECT txt FROM t WHERE txt IS NULL")->query();
+    VIX_CHECK(nulls->next());
+    VIX_CHECK(!std::get<0>(nulls->as<std::tuple<std::optional<Timestamp>>>()));
+
+    auto events = conn->prepare("SELECT 7, ts, dec FROM t")->query();
+    VIX_CHECK(events->next());
+    const Event e = events->as<Event>();
+    VIX_CHECK(e.id == 7 && e.at == ts && e.amount == dec);
+
+    // stored as integers: comparisons work in SQL
+    auto q = conn->prepare("SELECT count(*) FROM t WHERE ts = ? AND u = ?");
+    q->bind(1, ts);
+    q->bind(2, u);
+    auto c = q->query();
+    VIX_CHECK(c->next() && c->row().getInt64(0) == 2);
+  }
+} // namespace
+
+int main()
+{
+  test::run("timestampText", timestampText);
+  test::run("dateText", dateText);
+  test::run("decimalText", decimalText);
+  test::run("uuidText", uuidText);
+  test::run("sqliteRoundTrip", sqliteRoundTrip);
+  return test::report();
+}